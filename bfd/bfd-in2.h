@@ -527,6 +527,25 @@ extern bfd_boolean bfd_cache_close
 
 extern bfd_boolean bfd_cache_close_all (void);
 
+/* File descriptor cache statistics, see bfd_cache_get_stats.  */
+
+struct bfd_cache_stats
+{
+  /* The number of times a file was found still open after other
+     files had been used, so that reopening it was avoided.  */
+  unsigned long hits;
+  /* The number of times a file had to be reopened.  */
+  unsigned long reopens;
+  /* The number of files closed to make room for another.  */
+  unsigned long closes;
+  /* The maximum number of files the cache will keep open.  */
+  int max_open;
+};
+
+extern bfd_boolean bfd_cache_raise_limit (void);
+
+extern void bfd_cache_get_stats (struct bfd_cache_stats *);
+
 extern bfd_boolean bfd_record_phdr
   (bfd *, unsigned long, bfd_boolean, flagword, bfd_boolean, bfd_vma,
    bfd_boolean, bfd_boolean, unsigned int, struct bfd_section **);
@@ -686,6 +705,38 @@ extern long bfd_get_elf_phdr_upper_bound
 extern int bfd_get_elf_phdrs
   (bfd *abfd, void *phdrs);
 
+/* One address for bfd_elf_find_nearest_lines to look up, and the
+   source location found for it.  */
+struct bfd_line_lookup
+{
+  /* The address, a VMA.  Set by the caller.  */
+  bfd_vma address;
+
+  /* The source file, function and line containing ADDRESS, or NULL
+     and zero if they are not known.  */
+  const char *filename;
+  const char *functionname;
+  unsigned int line;
+  unsigned int discriminator;
+};
+
+/* Read all of the DWARF debugging information of ABFD, an executable
+   or shared library, so that bfd_elf_find_nearest_lines can be used.
+   SYMBOLS is ABFD's symbol table, or NULL.  Return FALSE if an error
+   occurs; bfd_get_error will return an appropriate code.  */
+extern bfd_boolean bfd_elf_prepare_line_lookups
+  (bfd *abfd, struct bfd_symbol **symbols);
+
+/* Look up the source location of each of the COUNT addresses in
+   LOOKUPS in ABFD's DWARF debugging information.  Unlike
+   bfd_find_nearest_line, this does not fall back on the symbol table
+   for function names.  ABFD must have been prepared with
+   bfd_elf_prepare_line_lookups.  Several threads may call this at
+   once on the same ABFD, as long as no other thread uses ABFD in any
+   other way meanwhile.  */
+extern bfd_boolean bfd_elf_find_nearest_lines
+  (bfd *abfd, struct bfd_line_lookup *lookups, bfd_size_type count);
+
 /* Create a new BFD as if by bfd_openr.  Rather than opening a file,
    reconstruct an ELF file by reading the segments out of remote
    memory based on the ELF file header at EHDR_VMA and the ELF program
@@ -1205,6 +1256,13 @@ void *bfd_mmap (bfd *abfd, void *addr, bfd_size_type len,
     int prot, int flags, file_ptr offset,
     void **map_addr, bfd_size_type *map_len);
 
+void *bfd_borrow_file_range (bfd *abfd, file_ptr offset,
+    bfd_size_type len,
+    void **map_addr, bfd_size_type *map_len);
+
+void bfd_return_borrowed_contents (void *ptr, void *map_addr,
+    bfd_size_type map_len);
+
 /* Extracted from bfdwin.c.  */
 /* Extracted from section.c.  */
 
@@ -7262,6 +7320,10 @@ bfd_boolean bfd_compress_section_contents
 bfd_boolean bfd_get_full_section_contents
    (bfd *abfd, asection *section, bfd_byte **ptr);
 
+bfd_boolean bfd_borrow_section_contents
+   (bfd *abfd, asection *section, bfd_byte **ptr,
+    void **map_addr, bfd_size_type *map_len);
+
 void bfd_cache_section_contents
    (asection *sec, void *contents);
 
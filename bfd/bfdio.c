@@ -26,6 +26,10 @@
 #include "bfd.h"
 #include "libbfd.h"
 
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
 #ifndef S_IXUSR
 #define S_IXUSR 0100    /* Execute by owner.  */
 #endif
@@ -463,6 +467,108 @@ bfd_mmap (bfd *abfd, void *addr, bfd_size_type len,
                              map_addr, map_len);
 }
 
+/* Borrowed ranges smaller than this are read into a malloc'd buffer;
+   for them the cost of setting up and tearing down a mapping exceeds
+   the cost of the copy.  */
+#define BORROW_MMAP_THRESHOLD (64 * 1024)
+
+/*
+FUNCTION
+	bfd_borrow_file_range
+
+SYNOPSIS
+	void *bfd_borrow_file_range (bfd *abfd, file_ptr offset,
+	                             bfd_size_type len,
+	                             void **map_addr, bfd_size_type *map_len);
+
+DESCRIPTION
+	Return a read-only view of @var{len} bytes of @var{abfd}
+	starting at @var{offset}, or NULL on error.  Large ranges of
+	files opened for reading are mmap()ed; otherwise, and for
+	in-memory BFDs, the bytes are read into a buffer allocated
+	with malloc.  The mapping (or NULL) is stored in
+	@var{map_addr} and @var{map_len}.  Release the view with
+	<<bfd_return_borrowed_contents>>.
+
+*/
+
+void *
+bfd_borrow_file_range (bfd *abfd, file_ptr offset, bfd_size_type len,
+		       void **map_addr, bfd_size_type *map_len)
+{
+  void *buf;
+
+  *map_addr = NULL;
+  *map_len = 0;
+
+#ifdef HAVE_MMAP
+  if (len >= BORROW_MMAP_THRESHOLD
+      && abfd->direction == read_direction
+      && (abfd->flags & BFD_IN_MEMORY) == 0
+      && offset >= 0)
+    {
+      ufile_ptr start = offset;
+      ufile_ptr filesize = bfd_get_size (abfd);
+
+      if (abfd->my_archive != NULL)
+	start += abfd->origin;
+
+      /* Touching a page beyond the end of the file raises SIGBUS, so
+	 only map ranges that the file really contains.  */
+      if (start + len >= start && start + len <= filesize)
+	{
+	  buf = bfd_mmap (abfd, NULL, len, PROT_READ, MAP_PRIVATE, offset,
+			  map_addr, map_len);
+	  if (buf != (void *) -1)
+	    return buf;
+	  *map_addr = NULL;
+	  *map_len = 0;
+	}
+    }
+#endif
+
+  buf = bfd_malloc (len);
+  if (buf == NULL)
+    return NULL;
+  if (bfd_seek (abfd, offset, SEEK_SET) != 0
+      || bfd_bread (buf, len, abfd) != len)
+    {
+      free (buf);
+      return NULL;
+    }
+  return buf;
+}
+
+/*
+FUNCTION
+	bfd_return_borrowed_contents
+
+SYNOPSIS
+	void bfd_return_borrowed_contents (void *ptr, void *map_addr,
+	                                   bfd_size_type map_len);
+
+DESCRIPTION
+	Release a view returned by <<bfd_borrow_file_range>> or
+	<<bfd_borrow_section_contents>>.  @var{map_addr} and
+	@var{map_len} are the values stored by that call.
+
+*/
+
+void
+bfd_return_borrowed_contents (void *ptr, void *map_addr,
+			      bfd_size_type map_len ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_MMAP
+  if (map_addr != NULL)
+    {
+      munmap (map_addr, map_len);
+      return;
+    }
+#endif
+  if (ptr != NULL)
+    free (ptr);
+}
+
 /* Memory file I/O operations.  */
 
 static file_ptr
@@ -100,6 +100,10 @@ bfd_cache_max_open (void)
 
 static int open_files;
 
+/* Cache statistics, returned by bfd_cache_get_stats.  */
+
+static struct bfd_cache_stats cache_stats;
+
 /* Zero, or a pointer to the topmost BFD on the chain.  This is
    used by the <<bfd_cache_lookup>> macro in @file{libbfd.h} to
    determine when it can avoid a function call.  */
@@ -164,29 +168,44 @@ bfd_cache_delete (bfd *abfd)
   return ret;
 }
 
+/* Return the least recently used cacheable BFD in the cache, or NULL
+   if there is none.  If READ_ONLY, only consider BFDs opened for
+   reading.  */
+
+static bfd *
+find_victim (bfd_boolean read_only)
+{
+  bfd *abfd;
+
+  if (bfd_last_cache == NULL)
+    return NULL;
+
+  abfd = bfd_last_cache->lru_prev;
+  while (! abfd->cacheable
+	 || (read_only
+	     && abfd->direction != read_direction
+	     && abfd->direction != no_direction))
+    {
+      if (abfd == bfd_last_cache)
+	return NULL;
+      abfd = abfd->lru_prev;
+    }
+  return abfd;
+}
+
 /* We need to open a new file, and the cache is full.  Find the least
-   recently used cacheable BFD and close it.  */
+   recently used cacheable BFD and close it.  Files opened for
+   writing are closed only if there is nothing else to close, since
+   they must be flushed and are expensive to reopen.  */
 
 static bfd_boolean
 close_one (void)
 {
   register bfd *to_kill;
 
-  if (bfd_last_cache == NULL)
-    to_kill = NULL;
-  else
-    {
-      for (to_kill = bfd_last_cache->lru_prev;
-	   ! to_kill->cacheable;
-	   to_kill = to_kill->lru_prev)
-	{
-	  if (to_kill == bfd_last_cache)
-	    {
-	      to_kill = NULL;
-	      break;
-	    }
-	}
-    }
+  to_kill = find_victim (TRUE);
+  if (to_kill == NULL)
+    to_kill = find_victim (FALSE);
 
   if (to_kill == NULL)
     {
@@ -195,6 +214,7 @@ close_one (void)
     }
 
   to_kill->where = real_ftell ((FILE *) to_kill->iostream);
+  cache_stats.closes++;
 
   return bfd_cache_delete (to_kill);
 }
@@ -228,11 +248,14 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
 
   if (abfd->iostream != NULL)
     {
-      /* Move the file to the start of the cache.  */
+      /* Move the file to the start of the cache.  Another file has
+	 been used since this one, so keeping it open has saved
+	 reopening it; count that as a hit.  */
       if (abfd != bfd_last_cache)
 	{
 	  snip (abfd);
 	  insert (abfd);
+	  cache_stats.hits++;
 	}
       return (FILE *) abfd->iostream;
     }
@@ -240,6 +263,7 @@ bfd_cache_lookup_worker (bfd *abfd, enum cache_flag flag)
   if (flag & CACHE_NO_OPEN)
     return NULL;
 
+  cache_stats.reopens++;
   if (bfd_open_file (abfd) == NULL)
     ;
   else if (!(flag & CACHE_NO_SEEK)
@@ -558,6 +582,102 @@ bfd_cache_close_all ()
   return ret;
 }
 
+/*
+FUNCTION
+	bfd_cache_raise_limit
+
+SYNOPSIS
+	bfd_boolean bfd_cache_raise_limit (void);
+
+DESCRIPTION
+	Raise the soft limit on open file descriptors to the hard
+	limit, if the system allows it, and let the cache keep more
+	files open to match.  The cache still uses only a fraction of
+	the descriptors, leaving the rest for output files and for the
+	application.  This changes a process-wide limit which is
+	inherited by child processes, so BFD never calls it itself.
+	Applications that open many files may call it; the linker
+	does so unconditionally at startup.
+
+RETURNS
+	<<TRUE>> if the cache size was increased, <<FALSE>> otherwise.
+*/
+
+bfd_boolean
+bfd_cache_raise_limit (void)
+{
+#ifdef HAVE_GETRLIMIT
+  struct rlimit rlim;
+  int old_max = bfd_cache_max_open ();
+
+  if (getrlimit (RLIMIT_NOFILE, &rlim) != 0
+      || rlim.rlim_cur == rlim.rlim_max
+      || rlim.rlim_cur == (rlim_t) RLIM_INFINITY)
+    return FALSE;
+
+  rlim.rlim_cur = rlim.rlim_max;
+  if (setrlimit (RLIMIT_NOFILE, &rlim) != 0)
+    return FALSE;
+
+  max_open_files = 0;
+  if (bfd_cache_max_open () > old_max)
+    return TRUE;
+  max_open_files = old_max;
+#endif /* HAVE_GETRLIMIT */
+  return FALSE;
+}
+
+/*
+FUNCTION
+	bfd_cache_get_stats
+
+SYNOPSIS
+	void bfd_cache_get_stats (struct bfd_cache_stats *stats);
+
+DESCRIPTION
+	Store the number of cache hits, files reopened and files closed
+	to make room for others so far in @var{stats}, along with the
+	current limit on the number of files kept open.
+*/
+
+void
+bfd_cache_get_stats (struct bfd_cache_stats *stats)
+{
+  *stats = cache_stats;
+  stats->max_open = bfd_cache_max_open ();
+}
+
+/*
+INTERNAL_FUNCTION
+	bfd_cache_shrink
+
+SYNOPSIS
+	bfd_boolean bfd_cache_shrink (void);
+
+DESCRIPTION
+	Called when opening a file has failed.  If that was because
+	the process ran out of file descriptors, lower the number of
+	files the cache keeps open to the number open now, and close
+	the least recently used one.
+
+RETURNS
+	<<TRUE>> if a file was closed and the open is worth retrying,
+	<<FALSE>> otherwise.
+*/
+
+bfd_boolean
+bfd_cache_shrink (void)
+{
+#ifdef EMFILE
+  if (errno == EMFILE && find_victim (FALSE) != NULL)
+    {
+      max_open_files = open_files;
+      return close_one ();
+    }
+#endif
+  return FALSE;
+}
+
 /*
 INTERNAL_FUNCTION
 	bfd_open_file
@@ -632,6 +752,11 @@ bfd_open_file (bfd *abfd)
       break;
     }
 
+  if (abfd->iostream == NULL
+      && abfd->direction == read_direction
+      && bfd_cache_shrink ())
+    abfd->iostream = real_fopen (abfd->filename, FOPEN_RB);
+
   if (abfd->iostream == NULL)
     bfd_set_error (bfd_error_system_call);
   else
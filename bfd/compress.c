@@ -254,6 +254,57 @@ bfd_get_full_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr)
     }
 }
 
+/*
+FUNCTION
+	bfd_borrow_section_contents
+
+SYNOPSIS
+	bfd_boolean bfd_borrow_section_contents
+	  (bfd *abfd, asection *section, bfd_byte **ptr,
+	   void **map_addr, bfd_size_type *map_len);
+
+DESCRIPTION
+	Like <<bfd_get_full_section_contents>> with a NULL @var{*ptr},
+	except that the contents returned in @var{*ptr} are read-only.
+	Uncompressed sections read straight from the file are mmap()ed
+	where possible instead of being copied; compressed and
+	in-memory sections are read as usual.  Release the contents with
+	<<bfd_return_borrowed_contents>>, passing the values stored
+	in @var{map_addr} and @var{map_len}.
+
+	Return @code{TRUE} if the full section contents is retrieved
+	successfully.
+*/
+
+bfd_boolean
+bfd_borrow_section_contents (bfd *abfd, sec_ptr sec, bfd_byte **ptr,
+			     void **map_addr, bfd_size_type *map_len)
+{
+  bfd_size_type sz;
+
+  *ptr = NULL;
+  *map_addr = NULL;
+  *map_len = 0;
+
+  if (abfd->direction != write_direction && sec->rawsize != 0)
+    sz = sec->rawsize;
+  else
+    sz = sec->size;
+
+  /* Only sections whose bytes sit unmodified in the file can be
+     mapped; anything else goes through the usual copying path.  */
+  if (sz == 0
+      || sec->compress_status != COMPRESS_SECTION_NONE
+      || (sec->flags & (SEC_HAS_CONTENTS | SEC_IN_MEMORY)) != SEC_HAS_CONTENTS
+      || abfd->xvec->_bfd_get_section_contents
+	 != _bfd_generic_get_section_contents)
+    return bfd_get_full_section_contents (abfd, sec, ptr);
+
+  *ptr = (bfd_byte *) bfd_borrow_file_range (abfd, sec->filepos, sz,
+					     map_addr, map_len);
+  return *ptr != NULL;
+}
+
 /*
 FUNCTION
 	bfd_cache_section_contents
@@ -81,6 +81,17 @@ struct adjusted_section
   bfd_vma adj_vma;
 };
 
+/* A section buffer that read_section mapped from the file rather
+   than reading into malloc'd memory.  */
+
+struct borrowed_section
+{
+  struct borrowed_section *next;
+  bfd_byte *buffer;
+  void *map_addr;
+  bfd_size_type map_len;
+};
+
 struct dwarf2_debug
 {
   /* A list of all previously read comp_units.  */
@@ -188,6 +199,76 @@ struct dwarf2_debug
 
   /* True if we opened bfd_ptr.  */
   bfd_boolean close_on_cleanup;
+
+  /* Section buffers that must be unmapped rather than freed.  */
+  struct borrowed_section *borrowed_sections;
+
+  /* Number of comp. units on all_comp_units.  */
+  unsigned int num_comp_units;
+
+  /* Address ranges of the comp. units read so far, used to find the
+     units that may contain an address without trying each of them.
+     The first num_sorted_unit_ranges entries are sorted by address;
+     the rest have been added since.  */
+  struct unit_range *unit_ranges;
+  unsigned int num_unit_ranges;
+  unsigned int num_sorted_unit_ranges;
+  unsigned int alloc_unit_ranges;
+
+  /* Comp. units that had no address range when they were read.  */
+  struct comp_unit **rangeless_units;
+  unsigned int num_rangeless_units;
+  unsigned int alloc_rangeless_units;
+
+  /* The units found by the last stash_find_units_for_address.  */
+  struct comp_unit **candidate_units;
+  unsigned int alloc_candidate_units;
+
+  /* Address ranges of the comp. units in .debug_info, taken from
+     .debug_aranges or .gdb_index and sorted by low address.  They let
+     us read the unit containing an address without reading all the
+     units before it.  */
+  struct info_arange *info_aranges;
+  unsigned int num_info_aranges;
+
+  /* Status of info_aranges.  */
+  int info_aranges_status;
+#define STASH_INFO_ARANGES_UNREAD  0
+#define STASH_INFO_ARANGES_READ    1
+#define STASH_INFO_ARANGES_NONE    2
+
+  /* Start of each comp. unit read through info_aranges, sorted.  The
+     sequential walk of .debug_info skips these.  */
+  bfd_byte **units_read_early;
+  unsigned int num_units_read_early;
+  unsigned int alloc_units_read_early;
+
+  /* True once every comp. unit has been read and decoded, and all the
+     lookup tables built, by _bfd_dwarf2_prepare_concurrent_lookups.
+     From then on _bfd_dwarf2_find_nearest_lines only reads the stash.  */
+  bfd_boolean concurrent_lookups;
+};
+
+/* An address range of the comp. unit at INFO_OFFSET in .debug_info.  */
+
+struct info_arange
+{
+  bfd_vma low;
+  bfd_vma high;
+  /* The highest HIGH of this and all preceding entries.  */
+  bfd_vma max_high;
+  bfd_uint64_t info_offset;
+};
+
+/* An address range of a comp. unit.  */
+
+struct unit_range
+{
+  bfd_vma low;
+  bfd_vma high;
+  /* The highest HIGH of this and all preceding sorted entries.  */
+  bfd_vma max_high;
+  struct comp_unit *unit;
 };
 
 struct arange
@@ -253,6 +334,13 @@ struct comp_unit
   /* A list of the functions found in this comp. unit.  */
   struct funcinfo *function_table;
 
+  /* The address ranges of the functions in function_table, sorted by
+     low address.  Built on the first lookup by address.  */
+  struct lookup_funcinfo *lookup_funcinfo_table;
+
+  /* Number of entries in lookup_funcinfo_table.  */
+  unsigned int number_of_funcinfo_ranges;
+
   /* A list of the variables found in this comp. unit.  */
   struct varinfo *variable_table;
 
@@ -274,6 +362,10 @@ struct comp_unit
 
   /* TRUE if symbols are cached in hash table for faster lookup by name.  */
   bfd_boolean cached;
+
+  /* One more than the number of units read before this one, or zero
+     if the unit is not on the stash's list of units.  */
+  unsigned int unit_number;
 };
 
 /* This data structure holds the information of an abbrev.  */
@@ -487,12 +579,15 @@ lookup_info_hash_table (struct info_hash_table *hash_table, const char *key)
 
 /* Read a section into its appropriate place in the dwarf2_debug
    struct (indicated by SECTION_BUFFER and SECTION_SIZE).  If SYMS is
-   not NULL, use bfd_simple_get_relocated_section_contents to read the
-   section contents, otherwise use bfd_get_section_contents.  Fail if
-   the located section does not contain at least OFFSET bytes.  */
+   not NULL and the section needs relocating, use
+   bfd_simple_get_relocated_section_contents to read the section
+   contents, otherwise borrow them with bfd_borrow_section_contents.
+   Fail if the located section does not contain at least OFFSET
+   bytes.  */
 
 static bfd_boolean
-read_section (bfd *           abfd,
+read_section (struct dwarf2_debug *stash,
+	      bfd *           abfd,
 	      const struct dwarf_debug_section *sec,
 	      asymbol **      syms,
 	      bfd_uint64_t    offset,
@@ -521,7 +616,9 @@ read_section (bfd *           abfd,
 	}
 
       *section_size = msec->rawsize ? msec->rawsize : msec->size;
-      if (syms)
+      if (syms
+	  && (abfd->flags & (HAS_RELOC | EXEC_P | DYNAMIC)) == HAS_RELOC
+	  && (msec->flags & SEC_RELOC) != 0)
 	{
 	  *section_buffer
 	    = bfd_simple_get_relocated_section_contents (abfd, msec, NULL, syms);
@@ -530,12 +627,38 @@ read_section (bfd *           abfd,
 	}
       else
 	{
-	  *section_buffer = (bfd_byte *) bfd_malloc (*section_size);
-	  if (! *section_buffer)
-	    return FALSE;
-	  if (! bfd_get_section_contents (abfd, msec, *section_buffer,
-					  0, *section_size))
+	  struct borrowed_section *borrowed;
+	  bfd_byte *contents;
+	  void *map_addr;
+	  bfd_size_type map_len;
+
+	  if (! bfd_borrow_section_contents (abfd, msec, &contents,
+					     &map_addr, &map_len))
 	    return FALSE;
+	  /* An empty section yields no buffer; keep handing back an
+	     allocated one as before.  */
+	  if (contents == NULL)
+	    {
+	      contents = (bfd_byte *) bfd_malloc (*section_size);
+	      if (contents == NULL)
+		return FALSE;
+	    }
+	  if (map_addr != NULL)
+	    {
+	      borrowed = (struct borrowed_section *)
+		bfd_malloc (sizeof (*borrowed));
+	      if (borrowed == NULL)
+		{
+		  bfd_return_borrowed_contents (contents, map_addr, map_len);
+		  return FALSE;
+		}
+	      borrowed->buffer = contents;
+	      borrowed->map_addr = map_addr;
+	      borrowed->map_len = map_len;
+	      borrowed->next = stash->borrowed_sections;
+	      stash->borrowed_sections = borrowed;
+	    }
+	  *section_buffer = contents;
 	}
     }
 
@@ -553,6 +676,31 @@ read_section (bfd *           abfd,
   return TRUE;
 }
 
+/* Release a buffer returned by read_section.  */
+
+static void
+free_section_buffer (struct dwarf2_debug *stash, bfd_byte *buffer)
+{
+  struct borrowed_section **pp;
+
+  if (buffer == NULL)
+    return;
+
+  for (pp = &stash->borrowed_sections; *pp != NULL; pp = &(*pp)->next)
+    if ((*pp)->buffer == buffer)
+      {
+	struct borrowed_section *borrowed = *pp;
+
+	*pp = borrowed->next;
+	bfd_return_borrowed_contents (buffer, borrowed->map_addr,
+				      borrowed->map_len);
+	free (borrowed);
+	return;
+      }
+
+  free (buffer);
+}
+
 /* VERBATIM
    The following function up to the END VERBATIM mark are
    copied directly from dwarf2read.c.  */
@@ -633,7 +781,7 @@ read_indirect_string (struct comp_unit * unit,
 
   *bytes_read_ptr = unit->offset_size;
 
-  if (! read_section (unit->abfd, &stash->debug_sections[debug_str],
+  if (! read_section (stash, unit->abfd, &stash->debug_sections[debug_str],
 		      stash->syms, offset,
 		      &stash->dwarf_str_buffer, &stash->dwarf_str_size))
     return NULL;
@@ -685,7 +833,7 @@ read_alt_indirect_string (struct comp_unit * unit,
       stash->alt_bfd_ptr = debug_bfd;
     }
   
-  if (! read_section (unit->stash->alt_bfd_ptr,
+  if (! read_section (stash, unit->stash->alt_bfd_ptr,
 		      stash->debug_sections + debug_str_alt,
 		      NULL, /* FIXME: Do we need to load alternate symbols ?  */
 		      offset,
@@ -731,7 +879,7 @@ read_alt_indirect_ref (struct comp_unit * unit,
       stash->alt_bfd_ptr = debug_bfd;
     }
   
-  if (! read_section (unit->stash->alt_bfd_ptr,
+  if (! read_section (stash, unit->stash->alt_bfd_ptr,
 		      stash->debug_sections + debug_info_alt,
 		      NULL, /* FIXME: Do we need to load alternate symbols ?  */
 		      offset,
@@ -743,40 +891,46 @@ read_alt_indirect_ref (struct comp_unit * unit,
 }
 
 static bfd_uint64_t
-read_address (struct comp_unit *unit, bfd_byte *buf)
+read_sized_address (bfd *abfd, unsigned int addr_size, bfd_byte *buf)
 {
-  int signed_vma = get_elf_backend_data (unit->abfd)->sign_extend_vma;
+  int signed_vma = get_elf_backend_data (abfd)->sign_extend_vma;
 
   if (signed_vma)
     {
-      switch (unit->addr_size)
+      switch (addr_size)
 	{
 	case 8:
-	  return bfd_get_signed_64 (unit->abfd, buf);
+	  return bfd_get_signed_64 (abfd, buf);
 	case 4:
-	  return bfd_get_signed_32 (unit->abfd, buf);
+	  return bfd_get_signed_32 (abfd, buf);
 	case 2:
-	  return bfd_get_signed_16 (unit->abfd, buf);
+	  return bfd_get_signed_16 (abfd, buf);
 	default:
 	  abort ();
 	}
     }
   else
     {
-      switch (unit->addr_size)
+      switch (addr_size)
 	{
 	case 8:
-	  return bfd_get_64 (unit->abfd, buf);
+	  return bfd_get_64 (abfd, buf);
 	case 4:
-	  return bfd_get_32 (unit->abfd, buf);
+	  return bfd_get_32 (abfd, buf);
 	case 2:
-	  return bfd_get_16 (unit->abfd, buf);
+	  return bfd_get_16 (abfd, buf);
 	default:
 	  abort ();
 	}
     }
 }
 
+static bfd_uint64_t
+read_address (struct comp_unit *unit, bfd_byte *buf)
+{
+  return read_sized_address (unit->abfd, unit->addr_size, buf);
+}
+
 /* Lookup an abbrev_info structure in the abbrev hash table.  */
 
 static struct abbrev_info *
@@ -814,7 +968,7 @@ read_abbrevs (bfd *abfd, bfd_uint64_t offset, struct dwarf2_debug *stash)
   unsigned int abbrev_form, hash_number;
   bfd_size_type amt;
 
-  if (! read_section (abfd, &stash->debug_sections[debug_abbrev],
+  if (! read_section (stash, abfd, &stash->debug_sections[debug_abbrev],
 		      stash->syms, offset,
 		      &stash->dwarf_abbrev_buffer, &stash->dwarf_abbrev_size))
     return NULL;
@@ -1130,6 +1284,8 @@ struct line_sequence
   bfd_vma               low_pc;
   struct line_sequence* prev_sequence;
   struct line_info*     last_line;  /* Largest VMA.  */
+  struct line_info**    line_info_lookup;  /* Lines by increasing VMA.  */
+  unsigned int          num_lines;
 };
 
 struct line_info_table
@@ -1171,6 +1327,19 @@ struct funcinfo
   asection *sec;
 };
 
+/* One address range of a function, for lookups by address.  */
+
+struct lookup_funcinfo
+{
+  struct funcinfo *funcinfo;
+  bfd_vma low;
+  bfd_vma high;
+  /* The highest HIGH of this and all preceding entries.  */
+  bfd_vma max_high;
+  /* Position of this range in a walk of the function table.  */
+  unsigned int order;
+};
+
 struct varinfo
 {
   /* Pointer to previous variable in list of all variables */
@@ -1279,6 +1448,8 @@ add_line_info (struct line_info_table *table,
       seq->low_pc = address;
       seq->prev_sequence = table->sequences;
       seq->last_line = info;
+      seq->line_info_lookup = NULL;
+      seq->num_lines = 0;
       table->lcl_head = info;
       table->sequences = seq;
       table->num_sequences++;
@@ -1390,8 +1561,39 @@ concat_filename (struct line_info_table *table, unsigned int file)
   return strdup (filename);
 }
 
+/* Record that UNIT covers LOW_PC to HIGH_PC in STASH's unit ranges.  */
+
+static bfd_boolean
+stash_add_unit_range (struct dwarf2_debug *stash, struct comp_unit *unit,
+		      bfd_vma low_pc, bfd_vma high_pc)
+{
+  struct unit_range *range;
+
+  if (stash->num_unit_ranges >= stash->alloc_unit_ranges)
+    {
+      unsigned int alloc = stash->alloc_unit_ranges * 2;
+      bfd_size_type amt;
+
+      if (alloc == 0)
+	alloc = 64;
+      amt = sizeof (struct unit_range) * alloc;
+      range = (struct unit_range *) bfd_realloc (stash->unit_ranges, amt);
+      if (range == NULL)
+	return FALSE;
+      stash->unit_ranges = range;
+      stash->alloc_unit_ranges = alloc;
+    }
+
+  range = &stash->unit_ranges[stash->num_unit_ranges++];
+  range->low = low_pc;
+  range->high = high_pc;
+  range->max_high = 0;
+  range->unit = unit;
+  return TRUE;
+}
+
 static bfd_boolean
-arange_add (const struct comp_unit *unit, struct arange *first_arange,
+arange_add (struct comp_unit *unit, struct arange *first_arange,
 	    bfd_vma low_pc, bfd_vma high_pc)
 {
   struct arange *arange;
@@ -1400,6 +1602,13 @@ arange_add (const struct comp_unit *unit, struct arange *first_arange,
   if (low_pc == high_pc)
     return TRUE;
 
+  /* Ranges of the unit itself are also indexed by address.  Whether
+     they extend an existing arange below or not, recording the new
+     part keeps the index covering exactly the unit's aranges.  */
+  if (first_arange == &unit->arange
+      && !stash_add_unit_range (unit->stash, unit, low_pc, high_pc))
+    return FALSE;
+
   /* If the first arange is empty, use it.  */
   if (first_arange->high == 0)
     {
@@ -1498,6 +1707,8 @@ sort_line_sequences (struct line_info_table* table)
       sequences[n].low_pc = seq->low_pc;
       sequences[n].prev_sequence = NULL;
       sequences[n].last_line = seq->last_line;
+      sequences[n].line_info_lookup = NULL;
+      sequences[n].num_lines = 0;
       seq = seq->prev_sequence;
       free (last_seq);
     }
@@ -1551,7 +1762,7 @@ decode_line_info (struct comp_unit *unit, struct dwarf2_debug *stash)
   unsigned int exop_len;
   bfd_size_type amt;
 
-  if (! read_section (abfd, &stash->debug_sections[debug_line],
+  if (! read_section (stash, abfd, &stash->debug_sections[debug_line],
 		      stash->syms, unit->line_offset,
 		      &stash->dwarf_line_buffer, &stash->dwarf_line_size))
     return NULL;
@@ -1920,6 +2131,56 @@ decode_line_info (struct comp_unit *unit, struct dwarf2_debug *stash)
   return NULL;
 }
 
+/* Build the array SEQ->line_info_lookup, holding the lines of SEQ in
+   increasing address order, so that they can be binary searched.  If
+   the lines turn out not to be sorted, or we run out of memory, leave
+   the array NULL; lookups then walk the list instead.  Either way
+   SEQ->num_lines is set, so that this is only tried once.  */
+
+static void
+build_line_info_table (struct line_info_table *table,
+		       struct line_sequence *seq)
+{
+  bfd_size_type amt;
+  struct line_info **line_info_lookup;
+  struct line_info *each_line;
+  unsigned int num_lines;
+  unsigned int line_index;
+
+  if (seq->num_lines != 0)
+    return;
+
+  /* Count the number of line information entries.  We could do this
+     as we build the list in add_line_info, but that would mean
+     counting lines in sequences we never look at.  */
+  num_lines = 0;
+  for (each_line = seq->last_line; each_line; each_line = each_line->prev_line)
+    num_lines++;
+
+  if (num_lines == 0)
+    return;
+  seq->num_lines = num_lines;
+
+  amt = sizeof (struct line_info *) * num_lines;
+  line_info_lookup = (struct line_info **) bfd_alloc (table->abfd, amt);
+  if (line_info_lookup == NULL)
+    return;
+
+  line_index = num_lines;
+  for (each_line = seq->last_line; each_line; each_line = each_line->prev_line)
+    {
+      line_info_lookup[--line_index] = each_line;
+      if (each_line->prev_line != NULL
+	  && each_line->prev_line->address > each_line->address)
+	{
+	  bfd_release (table->abfd, line_info_lookup);
+	  return;
+	}
+    }
+
+  seq->line_info_lookup = line_info_lookup;
+}
+
 /* If ADDR is within TABLE set the output parameters and return the
    range of addresses covered by the entry used to fill them out.
    Otherwise set * FILENAME_PTR to NULL and return 0.
@@ -1954,12 +2215,34 @@ lookup_address_in_line_info_table (struct line_info_table *table,
 
   if (seq && addr >= seq->low_pc && addr < seq->last_line->address)
     {
-      /* Note: seq->last_line should be a descendingly sorted list.  */
-      for (each_line = seq->last_line;
-	   each_line;
-	   each_line = each_line->prev_line)
-	if (addr >= each_line->address)
-	  break;
+      build_line_info_table (table, seq);
+      if (seq->line_info_lookup != NULL)
+	{
+	  unsigned int lo, hi;
+
+	  /* Find the last line at or below ADDR.  */
+	  lo = 0;
+	  hi = seq->num_lines;
+	  while (lo < hi)
+	    {
+	      unsigned int m = (lo + hi) / 2;
+
+	      if (addr < seq->line_info_lookup[m]->address)
+		hi = m;
+	      else
+		lo = m + 1;
+	    }
+	  each_line = lo != 0 ? seq->line_info_lookup[lo - 1] : NULL;
+	}
+      else
+	{
+	  /* Note: seq->last_line should be a descendingly sorted list.  */
+	  for (each_line = seq->last_line;
+	       each_line;
+	       each_line = each_line->prev_line)
+	    if (addr >= each_line->address)
+	      break;
+	}
 
       if (each_line
 	  && !(each_line->end_sequence || each_line == seq->last_line))
@@ -1982,13 +2265,97 @@ static bfd_boolean
 read_debug_ranges (struct comp_unit *unit)
 {
   struct dwarf2_debug *stash = unit->stash;
-  return read_section (unit->abfd, &stash->debug_sections[debug_ranges],
-		       stash->syms, 0,
+  return read_section (stash, unit->abfd,
+		       &stash->debug_sections[debug_ranges], stash->syms, 0,
 		       &stash->dwarf_ranges_buffer, &stash->dwarf_ranges_size);
 }
 
 /* Function table functions.  */
 
+/* Compare function for lookup_funcinfo entries.  */
+
+static int
+compare_lookup_funcinfos (const void *a, const void *b)
+{
+  const struct lookup_funcinfo *lf1 = (const struct lookup_funcinfo *) a;
+  const struct lookup_funcinfo *lf2 = (const struct lookup_funcinfo *) b;
+
+  if (lf1->low < lf2->low)
+    return -1;
+  if (lf1->low > lf2->low)
+    return 1;
+  if (lf1->order < lf2->order)
+    return -1;
+  if (lf1->order > lf2->order)
+    return 1;
+  return 0;
+}
+
+/* Build UNIT->lookup_funcinfo_table from UNIT's function table.  */
+
+static bfd_boolean
+build_lookup_funcinfo_table (struct comp_unit *unit)
+{
+  struct lookup_funcinfo *lookup_funcinfo_table;
+  struct funcinfo *each_func;
+  struct arange *arange;
+  unsigned int number_of_ranges;
+  unsigned int i;
+  bfd_vma max_high;
+  bfd_size_type amt;
+
+  number_of_ranges = 0;
+  for (each_func = unit->function_table;
+       each_func;
+       each_func = each_func->prev_func)
+    for (arange = &each_func->arange; arange; arange = arange->next)
+      if (arange->low < arange->high)
+	number_of_ranges++;
+
+  if (number_of_ranges == 0)
+    return TRUE;
+
+  amt = sizeof (struct lookup_funcinfo) * number_of_ranges;
+  lookup_funcinfo_table = (struct lookup_funcinfo *) bfd_alloc (unit->abfd,
+								  amt);
+  if (lookup_funcinfo_table == NULL)
+    return FALSE;
+
+  /* ORDER counts every range, including empty ones, so that ties are
+     broken the same way as a walk of the function table would.  */
+  i = 0;
+  number_of_ranges = 0;
+  for (each_func = unit->function_table;
+       each_func;
+       each_func = each_func->prev_func)
+    for (arange = &each_func->arange; arange; arange = arange->next, i++)
+      if (arange->low < arange->high)
+	{
+	  struct lookup_funcinfo *entry;
+
+	  entry = &lookup_funcinfo_table[number_of_ranges++];
+	  entry->funcinfo = each_func;
+	  entry->low = arange->low;
+	  entry->high = arange->high;
+	  entry->order = i;
+	}
+
+  qsort (lookup_funcinfo_table, number_of_ranges,
+	 sizeof (struct lookup_funcinfo), compare_lookup_funcinfos);
+
+  max_high = 0;
+  for (i = 0; i < number_of_ranges; i++)
+    {
+      if (lookup_funcinfo_table[i].high > max_high)
+	max_high = lookup_funcinfo_table[i].high;
+      lookup_funcinfo_table[i].max_high = max_high;
+    }
+
+  unit->lookup_funcinfo_table = lookup_funcinfo_table;
+  unit->number_of_funcinfo_ranges = number_of_ranges;
+  return TRUE;
+}
+
 /* If ADDR is within UNIT's function tables, set FUNCTIONNAME_PTR, and return
    TRUE.  Note that we need to find the function that has the smallest range
    that contains ADDR, to handle inlined functions without depending upon
@@ -2000,35 +2367,52 @@ lookup_address_in_function_table (struct comp_unit *unit,
 				  struct funcinfo **function_ptr,
 				  const char **functionname_ptr)
 {
-  struct funcinfo* each_func;
-  struct funcinfo* best_fit = NULL;
+  struct lookup_funcinfo *table;
+  struct lookup_funcinfo *best_fit = NULL;
   bfd_vma best_fit_len = 0;
-  struct arange *arange;
+  unsigned int low, high, mid;
 
-  for (each_func = unit->function_table;
-       each_func;
-       each_func = each_func->prev_func)
+  if (unit->lookup_funcinfo_table == NULL
+      && !build_lookup_funcinfo_table (unit))
+    return FALSE;
+
+  /* Find the first range that might contain ADDR: MAX_HIGH never
+     decreases along the table.  Every range from there up to the
+     first one starting above ADDR is a candidate.  */
+  table = unit->lookup_funcinfo_table;
+  low = 0;
+  high = unit->number_of_funcinfo_ranges;
+  while (low < high)
     {
-      for (arange = &each_func->arange;
-	   arange;
-	   arange = arange->next)
+      mid = (low + high) / 2;
+      if (addr < table[mid].max_high)
+	high = mid;
+      else
+	low = mid + 1;
+    }
+
+  for (; low < unit->number_of_funcinfo_ranges; low++)
+    {
+      struct lookup_funcinfo *entry = &table[low];
+
+      if (addr < entry->low)
+	break;
+      if (addr >= entry->high)
+	continue;
+      if (!best_fit
+	  || entry->high - entry->low < best_fit_len
+	  || (entry->high - entry->low == best_fit_len
+	      && entry->order < best_fit->order))
 	{
-	  if (addr >= arange->low && addr < arange->high)
-	    {
-	      if (!best_fit
-		  || arange->high - arange->low < best_fit_len)
-		{
-		  best_fit = each_func;
-		  best_fit_len = arange->high - arange->low;
-		}
-	    }
+	  best_fit = entry;
+	  best_fit_len = entry->high - entry->low;
 	}
     }
 
   if (best_fit)
     {
-      *functionname_ptr = best_fit->name;
-      *function_ptr = best_fit;
+      *functionname_ptr = best_fit->funcinfo->name;
+      *function_ptr = best_fit->funcinfo;
       return TRUE;
     }
   else
@@ -2539,7 +2923,8 @@ static struct comp_unit *
 parse_comp_unit (struct dwarf2_debug *stash,
 		 bfd_vma unit_length,
 		 bfd_byte *info_ptr_unit,
-		 unsigned int offset_size)
+		 unsigned int offset_size,
+		 bfd_byte *info_ptr)
 {
   struct comp_unit* unit;
   unsigned int version;
@@ -2549,7 +2934,6 @@ parse_comp_unit (struct dwarf2_debug *stash,
   unsigned int abbrev_number, bytes_read, i;
   struct abbrev_info *abbrev;
   struct attribute attr;
-  bfd_byte *info_ptr = stash->info_ptr;
   bfd_byte *end_ptr = info_ptr + unit_length;
   bfd_size_type amt;
   bfd_vma low_pc = 0;
@@ -2731,105 +3115,345 @@ comp_unit_contains_address (struct comp_unit *unit, bfd_vma addr)
   return FALSE;
 }
 
-/* If UNIT contains ADDR, set the output parameters to the values for
-   the line containing ADDR.  The output parameters, FILENAME_PTR,
-   FUNCTIONNAME_PTR, and LINENUMBER_PTR, are pointers to the objects
-   to be filled in.
-
-   Returns the range of addresses covered by the entry that was used
-   to fill in *LINENUMBER_PTR or 0 if it was not filled in.  */
+/* Compare function for unit ranges.  */
 
-static bfd_vma
-comp_unit_find_nearest_line (struct comp_unit *unit,
-			     bfd_vma addr,
-			     const char **filename_ptr,
-			     const char **functionname_ptr,
-			     unsigned int *linenumber_ptr,
-			     unsigned int *discriminator_ptr,
-			     struct dwarf2_debug *stash)
+static int
+compare_unit_ranges (const void *a, const void *b)
 {
-  bfd_boolean func_p;
-  struct funcinfo *function;
-
-  if (unit->error)
-    return FALSE;
+  const struct unit_range *r1 = (const struct unit_range *) a;
+  const struct unit_range *r2 = (const struct unit_range *) b;
 
-  if (! unit->line_table)
-    {
-      if (! unit->stmtlist)
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
+  if (r1->low < r2->low)
+    return -1;
+  if (r1->low > r2->low)
+    return 1;
+  if (r1->high < r2->high)
+    return -1;
+  if (r1->high > r2->high)
+    return 1;
+  return 0;
+}
 
-      unit->line_table = decode_line_info (unit, stash);
+/* Merge the unit ranges added since the last call into the sorted
+   part of STASH's unit ranges.  */
 
-      if (! unit->line_table)
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
+static bfd_boolean
+stash_sort_unit_ranges (struct dwarf2_debug *stash)
+{
+  struct unit_range *ranges = stash->unit_ranges;
+  struct unit_range *added;
+  unsigned int num_sorted = stash->num_sorted_unit_ranges;
+  unsigned int num_added = stash->num_unit_ranges - num_sorted;
+  unsigned int i, j, k;
+  bfd_vma max_high;
+
+  if (num_added == 0)
+    return TRUE;
 
-      if (unit->first_child_die_ptr < unit->end_ptr
-	  && ! scan_unit_for_symbols (unit))
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
+  added = (struct unit_range *) bfd_malloc (sizeof (*added) * num_added);
+  if (added == NULL)
+    return FALSE;
+  memcpy (added, ranges + num_sorted, sizeof (*added) * num_added);
+  qsort (added, num_added, sizeof (*added), compare_unit_ranges);
+
+  /* Merge from the top down, so that no sorted entry is overwritten
+     before it has been moved.  */
+  i = num_sorted;
+  j = num_added;
+  k = num_sorted + num_added;
+  while (j > 0)
+    {
+      if (i > 0 && compare_unit_ranges (&ranges[i - 1], &added[j - 1]) > 0)
+	ranges[--k] = ranges[--i];
+      else
+	ranges[--k] = added[--j];
     }
+  free (added);
 
-  function = NULL;
-  func_p = lookup_address_in_function_table (unit, addr,
-					     &function, functionname_ptr);
-  if (func_p && (function->tag == DW_TAG_inlined_subroutine))
-    stash->inliner_chain = function;
-
-  return lookup_address_in_line_info_table (unit->line_table, addr,
-					    filename_ptr,
-					    linenumber_ptr,
-					    discriminator_ptr);
+  max_high = 0;
+  for (i = 0; i < stash->num_unit_ranges; i++)
+    {
+      if (ranges[i].high > max_high)
+	max_high = ranges[i].high;
+      ranges[i].max_high = max_high;
+    }
+  stash->num_sorted_unit_ranges = stash->num_unit_ranges;
+  return TRUE;
 }
 
-/* Check to see if line info is already decoded in a comp_unit.
-   If not, decode it.  Returns TRUE if no errors were encountered;
-   FALSE otherwise.  */
+/* Add UNIT to the *COUNT units in *UNITS, which has room for *ALLOC,
+   unless UNIT is not on the stash's list of units.  */
 
 static bfd_boolean
-comp_unit_maybe_decode_line_info (struct comp_unit *unit,
-				  struct dwarf2_debug *stash)
+add_candidate_unit (struct comp_unit *unit, struct comp_unit ***units,
+		    unsigned int *alloc, unsigned int *count)
 {
-  if (unit->error)
-    return FALSE;
+  if (unit->unit_number == 0)
+    return TRUE;
 
-  if (! unit->line_table)
+  if (*count >= *alloc)
     {
-      if (! unit->stmtlist)
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
-
-      unit->line_table = decode_line_info (unit, stash);
+      unsigned int new_alloc = *alloc ? *alloc * 2 : 16;
+      struct comp_unit **new_units;
 
-      if (! unit->line_table)
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
-
-      if (unit->first_child_die_ptr < unit->end_ptr
-	  && ! scan_unit_for_symbols (unit))
-	{
-	  unit->error = 1;
-	  return FALSE;
-	}
+      new_units = (struct comp_unit **)
+	bfd_realloc (*units, sizeof (*new_units) * new_alloc);
+      if (new_units == NULL)
+	return FALSE;
+      *units = new_units;
+      *alloc = new_alloc;
     }
-
+  (*units)[(*count)++] = unit;
   return TRUE;
 }
 
-/* If UNIT contains SYM at ADDR, set the output parameters to the
-   values for the line containing SYM.  The output parameters,
+/* Compare function for candidate units, putting the most recently
+   read unit first as on the stash's list of units.  */
+
+static int
+compare_candidate_units (const void *a, const void *b)
+{
+  const struct comp_unit *u1 = *(const struct comp_unit * const *) a;
+  const struct comp_unit *u2 = *(const struct comp_unit * const *) b;
+
+  if (u1->unit_number > u2->unit_number)
+    return -1;
+  if (u1->unit_number < u2->unit_number)
+    return 1;
+  return 0;
+}
+
+/* Find the comp. units read so far that may contain ADDR: those with
+   an arange containing ADDR and those with no arange at all.  Store
+   them in *UNITS, which has room for *ALLOC units, in the order of the
+   stash's list of units, and their number in *COUNT.  These are
+   exactly the units for which "arange.high == 0 ||
+   comp_unit_contains_address" can hold.  This does not change
+   STASH.  */
+
+static bfd_boolean
+find_units_for_address (struct dwarf2_debug *stash, bfd_vma addr,
+			struct comp_unit ***units, unsigned int *alloc,
+			unsigned int *count)
+{
+  struct unit_range *ranges;
+  unsigned int low, high, mid;
+  unsigned int i, n;
+
+  n = 0;
+  ranges = stash->unit_ranges;
+  low = 0;
+  high = stash->num_sorted_unit_ranges;
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      if (addr < ranges[mid].max_high)
+	high = mid;
+      else
+	low = mid + 1;
+    }
+  for (; low < stash->num_sorted_unit_ranges; low++)
+    {
+      if (addr < ranges[low].low)
+	break;
+      if (addr < ranges[low].high
+	  && !add_candidate_unit (ranges[low].unit, units, alloc, &n))
+	return FALSE;
+    }
+
+  for (i = stash->num_sorted_unit_ranges; i < stash->num_unit_ranges; i++)
+    if (addr >= ranges[i].low && addr < ranges[i].high
+	&& !add_candidate_unit (ranges[i].unit, units, alloc, &n))
+      return FALSE;
+
+  for (i = 0; i < stash->num_rangeless_units; i++)
+    if (stash->rangeless_units[i]->arange.high == 0
+	&& !add_candidate_unit (stash->rangeless_units[i], units, alloc, &n))
+      return FALSE;
+
+  if (n > 1)
+    {
+      qsort (*units, n, sizeof (struct comp_unit *),
+	     compare_candidate_units);
+      for (i = 1, low = 1; i < n; i++)
+	if ((*units)[i] != (*units)[low - 1])
+	  (*units)[low++] = (*units)[i];
+      n = low;
+    }
+
+  *count = n;
+  return TRUE;
+}
+
+/* Drop the units that have gained ranges from their line table since
+   they were read from STASH's rangeless units; the unit ranges cover
+   them now.  */
+
+static void
+stash_prune_rangeless_units (struct dwarf2_debug *stash)
+{
+  unsigned int i, n;
+
+  for (i = 0, n = 0; i < stash->num_rangeless_units; i++)
+    if (stash->rangeless_units[i]->arange.high == 0)
+      stash->rangeless_units[n++] = stash->rangeless_units[i];
+  stash->num_rangeless_units = n;
+}
+
+/* Find the comp. units that may contain ADDR, as find_units_for_address
+   does, storing them in STASH->candidate_units.  */
+
+static bfd_boolean
+stash_find_units_for_address (struct dwarf2_debug *stash, bfd_vma addr,
+			      unsigned int *count)
+{
+  /* Below this many unsorted ranges, scanning them is cheaper than
+     merging them into the sorted ones.  */
+  const unsigned int max_unsorted_unit_ranges = 16;
+
+  if (stash->num_unit_ranges - stash->num_sorted_unit_ranges
+      > max_unsorted_unit_ranges
+      && !stash_sort_unit_ranges (stash))
+    return FALSE;
+
+  stash_prune_rangeless_units (stash);
+
+  return find_units_for_address (stash, addr, &stash->candidate_units,
+				 &stash->alloc_candidate_units, count);
+}
+
+/* Add UNIT, which has just been read, to the end of STASH's list of
+   units.  */
+
+static bfd_boolean
+stash_add_comp_unit (struct dwarf2_debug *stash, struct comp_unit *unit)
+{
+  if (unit->arange.high == 0)
+    {
+      if (stash->num_rangeless_units >= stash->alloc_rangeless_units)
+	{
+	  unsigned int alloc = stash->alloc_rangeless_units * 2;
+	  struct comp_unit **units;
+
+	  if (alloc == 0)
+	    alloc = 16;
+	  units = (struct comp_unit **)
+	    bfd_realloc (stash->rangeless_units, sizeof (*units) * alloc);
+	  if (units == NULL)
+	    return FALSE;
+	  stash->rangeless_units = units;
+	  stash->alloc_rangeless_units = alloc;
+	}
+      stash->rangeless_units[stash->num_rangeless_units++] = unit;
+    }
+
+  if (stash->all_comp_units)
+    stash->all_comp_units->prev_unit = unit;
+  else
+    stash->last_comp_unit = unit;
+
+  unit->next_unit = stash->all_comp_units;
+  stash->all_comp_units = unit;
+  unit->unit_number = ++stash->num_comp_units;
+  return TRUE;
+}
+
+/* Check to see if line info is already decoded in a comp_unit.
+   If not, decode it.  Returns TRUE if no errors were encountered;
+   FALSE otherwise.  */
+
+static bfd_boolean
+comp_unit_maybe_decode_line_info (struct comp_unit *unit,
+				  struct dwarf2_debug *stash)
+{
+  if (unit->error)
+    return FALSE;
+
+  if (! unit->line_table)
+    {
+      if (! unit->stmtlist)
+	{
+	  unit->error = 1;
+	  return FALSE;
+	}
+
+      unit->line_table = decode_line_info (unit, stash);
+
+      if (! unit->line_table)
+	{
+	  unit->error = 1;
+	  return FALSE;
+	}
+
+      if (unit->first_child_die_ptr < unit->end_ptr
+	  && ! scan_unit_for_symbols (unit))
+	{
+	  unit->error = 1;
+	  return FALSE;
+	}
+    }
+
+  return TRUE;
+}
+
+/* Look up ADDR in UNIT, whose line info has been decoded, as
+   comp_unit_find_nearest_line does.  Also set *FUNCTION_PTR to the
+   function containing ADDR, or NULL.  This does not change UNIT once
+   its lookup tables have been built.  */
+
+static bfd_vma
+comp_unit_lookup_address (struct comp_unit *unit,
+			  bfd_vma addr,
+			  struct funcinfo **function_ptr,
+			  const char **filename_ptr,
+			  const char **functionname_ptr,
+			  unsigned int *linenumber_ptr,
+			  unsigned int *discriminator_ptr)
+{
+  *function_ptr = NULL;
+  lookup_address_in_function_table (unit, addr, function_ptr,
+				    functionname_ptr);
+
+  return lookup_address_in_line_info_table (unit->line_table, addr,
+					    filename_ptr,
+					    linenumber_ptr,
+					    discriminator_ptr);
+}
+
+/* If UNIT contains ADDR, set the output parameters to the values for
+   the line containing ADDR.  The output parameters, FILENAME_PTR,
+   FUNCTIONNAME_PTR, and LINENUMBER_PTR, are pointers to the objects
+   to be filled in.
+
+   Returns the range of addresses covered by the entry that was used
+   to fill in *LINENUMBER_PTR or 0 if it was not filled in.  */
+
+static bfd_vma
+comp_unit_find_nearest_line (struct comp_unit *unit,
+			     bfd_vma addr,
+			     const char **filename_ptr,
+			     const char **functionname_ptr,
+			     unsigned int *linenumber_ptr,
+			     unsigned int *discriminator_ptr,
+			     struct dwarf2_debug *stash)
+{
+  struct funcinfo *function;
+  bfd_vma range;
+
+  if (!comp_unit_maybe_decode_line_info (unit, stash))
+    return FALSE;
+
+  range = comp_unit_lookup_address (unit, addr, &function,
+				    filename_ptr, functionname_ptr,
+				    linenumber_ptr, discriminator_ptr);
+  if (function != NULL && function->tag == DW_TAG_inlined_subroutine)
+    stash->inliner_chain = function;
+
+  return range;
+}
+
+/* If UNIT contains SYM at ADDR, set the output parameters to the
+   values for the line containing SYM.  The output parameters,
    FILENAME_PTR, and LINENUMBER_PTR, are pointers to the objects to be
    filled in.
 
@@ -3546,8 +4170,8 @@ _bfd_dwarf2_slurp_debug_info (bfd *abfd, bfd *debug_bfd,
     {
       /* Case 1: only one info section.  */
       total_size = msec->size;
-      if (! read_section (debug_bfd, &stash->debug_sections[debug_info],
-			  symbols, 0,
+      if (! read_section (stash, debug_bfd,
+			  &stash->debug_sections[debug_info], symbols, 0,
 			  &stash->info_ptr_memory, &total_size))
 	return FALSE;
     }
@@ -3590,6 +4214,620 @@ _bfd_dwarf2_slurp_debug_info (bfd *abfd, bfd *debug_bfd,
   return TRUE;
 }
 
+/* Read the initial length field of the comp. unit at INFO_PTR and
+   return the unit length.  Store the size of the unit's DWARF offsets
+   in *OFFSET_SIZE and the size of the length field in *LENGTH_SIZE.  */
+
+static bfd_vma
+read_unit_length (bfd *abfd, bfd_byte *info_ptr,
+		  unsigned int *offset_size, unsigned int *length_size)
+{
+  bfd_vma length = read_4_bytes (abfd, info_ptr);
+
+  /* A 0xffffff length is the DWARF3 way of indicating
+     we use 64-bit offsets, instead of 32-bit offsets.  */
+  if (length == 0xffffffff)
+    {
+      *offset_size = 8;
+      *length_size = 12;
+      return read_8_bytes (abfd, info_ptr + 4);
+    }
+
+  /* A zero length is the IRIX way of indicating 64-bit offsets,
+     mostly because the 64-bit length will generally fit in 32
+     bits, and the endianness helps.  */
+  if (length == 0)
+    {
+      *offset_size = 8;
+      *length_size = 8;
+      return read_4_bytes (abfd, info_ptr + 4);
+    }
+
+  /* In the absence of the hints above, we assume 32-bit DWARF2
+     offsets even for targets with 64-bit addresses, because:
+       a) most of the time these targets will not have generated
+	  more than 2Gb of debug info and so will not need 64-bit
+	  offsets,
+     and
+       b) if they do use 64-bit offsets but they are not using
+	  the size hints that are tested for above then they are
+	  not conforming to the DWARF3 standard anyway.  */
+  *offset_size = 4;
+  *length_size = 4;
+  return length;
+}
+
+/* Add LOW to HIGH in the unit at INFO_OFFSET to STASH's info
+   aranges, of which there is room for *ALLOC.  */
+
+static bfd_boolean
+add_info_arange (struct dwarf2_debug *stash, unsigned int *alloc,
+		 bfd_vma low, bfd_vma high, bfd_uint64_t info_offset)
+{
+  struct info_arange *arange;
+
+  if (low >= high)
+    return TRUE;
+
+  if (stash->num_info_aranges >= *alloc)
+    {
+      unsigned int new_alloc = *alloc ? *alloc * 2 : 64;
+
+      arange = (struct info_arange *)
+	bfd_realloc (stash->info_aranges, sizeof (*arange) * new_alloc);
+      if (arange == NULL)
+	return FALSE;
+      stash->info_aranges = arange;
+      *alloc = new_alloc;
+    }
+
+  arange = &stash->info_aranges[stash->num_info_aranges++];
+  arange->low = low;
+  arange->high = high;
+  arange->max_high = 0;
+  arange->info_offset = info_offset;
+  return TRUE;
+}
+
+/* Add the address ranges listed in the .debug_aranges section
+   contents BUF, of SIZE bytes, to STASH's info aranges.  */
+
+static bfd_boolean
+read_debug_aranges (struct dwarf2_debug *stash, unsigned int *alloc,
+		    bfd_byte *buf, bfd_size_type size)
+{
+  bfd *abfd = stash->bfd_ptr;
+  bfd_byte *end = buf + size;
+  bfd_byte *set_ptr = buf;
+
+  while ((bfd_size_type) (end - set_ptr) >= 12)
+    {
+      bfd_byte *ptr = set_ptr;
+      bfd_byte *set_end;
+      bfd_vma length;
+      bfd_uint64_t info_offset;
+      unsigned int offset_size, length_size, addr_size, tuple_size;
+
+      length = read_unit_length (abfd, ptr, &offset_size, &length_size);
+      if ((bfd_size_type) (end - ptr) < length_size
+	  || length > (bfd_size_type) (end - ptr) - length_size)
+	break;
+      ptr += length_size;
+      set_end = ptr + length;
+
+      /* Version, .debug_info offset, address and segment size.  */
+      if ((bfd_size_type) (set_end - ptr) < 4 + offset_size)
+	break;
+      if (read_2_bytes (abfd, ptr) != 2)
+	{
+	  set_ptr = set_end;
+	  continue;
+	}
+      ptr += 2;
+      if (offset_size == 4)
+	info_offset = read_4_bytes (abfd, ptr);
+      else
+	info_offset = read_8_bytes (abfd, ptr);
+      ptr += offset_size;
+      addr_size = read_1_byte (abfd, ptr);
+      if ((addr_size != 2 && addr_size != 4 && addr_size != 8)
+	  || read_1_byte (abfd, ptr + 1) != 0)
+	{
+	  set_ptr = set_end;
+	  continue;
+	}
+      ptr += 2;
+
+      /* The tuples are aligned to twice the address size from the
+	 start of the set.  */
+      tuple_size = 2 * addr_size;
+      ptr = set_ptr + ((ptr - set_ptr + tuple_size - 1)
+		       / tuple_size * tuple_size);
+
+      while (ptr < set_end && (bfd_size_type) (set_end - ptr) >= tuple_size)
+	{
+	  bfd_vma low = read_sized_address (abfd, addr_size, ptr);
+	  bfd_vma len = read_sized_address (abfd, addr_size, ptr + addr_size);
+
+	  ptr += tuple_size;
+	  if (low == 0 && len == 0)
+	    break;
+	  if (!add_info_arange (stash, alloc, low, low + len, info_offset))
+	    return FALSE;
+	}
+
+      set_ptr = set_end;
+    }
+
+  return TRUE;
+}
+
+/* Add the address ranges in the address area of the .gdb_index
+   section contents BUF, of SIZE bytes, to STASH's info aranges.  The
+   index is always little-endian.  */
+
+static bfd_boolean
+read_gdb_index_aranges (struct dwarf2_debug *stash, unsigned int *alloc,
+			bfd_byte *buf, bfd_size_type size)
+{
+  bfd_vma cu_list, types_list, addr_area, symtab;
+  bfd_vma num_cus;
+  bfd_byte *ptr, *end;
+
+  /* Version 7 is the one gold writes; the address area layout has
+     been stable since version 4.  */
+  if (size < 24 || bfd_getl32 (buf) < 4 || bfd_getl32 (buf) > 8)
+    return TRUE;
+  cu_list = bfd_getl32 (buf + 4);
+  types_list = bfd_getl32 (buf + 8);
+  addr_area = bfd_getl32 (buf + 12);
+  symtab = bfd_getl32 (buf + 16);
+  if (cu_list > types_list || types_list > addr_area
+      || addr_area > symtab || symtab > size)
+    return TRUE;
+
+  num_cus = (types_list - cu_list) / 16;
+  end = buf + symtab;
+  for (ptr = buf + addr_area; end - ptr >= 20; ptr += 20)
+    {
+      bfd_vma cu_index = bfd_getl32 (ptr + 16);
+
+      /* Indices past the CU list refer to type units.  */
+      if (cu_index >= num_cus)
+	continue;
+      if (!add_info_arange (stash, alloc, bfd_getl64 (ptr),
+			    bfd_getl64 (ptr + 8),
+			    bfd_getl64 (buf + cu_list + cu_index * 16)))
+	return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* Compare function for info aranges.  */
+
+static int
+compare_info_aranges (const void *a, const void *b)
+{
+  const struct info_arange *r1 = (const struct info_arange *) a;
+  const struct info_arange *r2 = (const struct info_arange *) b;
+
+  if (r1->low < r2->low)
+    return -1;
+  if (r1->low > r2->low)
+    return 1;
+  if (r1->high < r2->high)
+    return -1;
+  if (r1->high > r2->high)
+    return 1;
+  return 0;
+}
+
+/* Compare function for .debug_info offsets.  */
+
+static int
+compare_info_offsets (const void *a, const void *b)
+{
+  bfd_uint64_t o1 = *(const bfd_uint64_t *) a;
+  bfd_uint64_t o2 = *(const bfd_uint64_t *) b;
+
+  return o1 < o2 ? -1 : o1 > o2 ? 1 : 0;
+}
+
+/* Drop the info aranges of STASH that do not point at the start of a
+   comp. unit in .debug_info, so that a bad index cannot make us parse
+   from the middle of a unit.  */
+
+static bfd_boolean
+stash_check_info_aranges (struct dwarf2_debug *stash)
+{
+  bfd_uint64_t *unit_offsets;
+  unsigned int num_units, alloc_units, i, n;
+  bfd_byte *ptr = stash->info_ptr_memory;
+  bfd_byte *end = stash->info_ptr_end;
+
+  unit_offsets = NULL;
+  num_units = 0;
+  alloc_units = 0;
+  while (end - ptr >= 12)
+    {
+      unsigned int offset_size, length_size;
+      bfd_vma length;
+
+      length = read_unit_length (stash->bfd_ptr, ptr,
+				 &offset_size, &length_size);
+      if (length > (bfd_size_type) (end - ptr) - length_size)
+	break;
+      if (length > 0)
+	{
+	  if (num_units >= alloc_units)
+	    {
+	      bfd_uint64_t *offsets;
+
+	      alloc_units = alloc_units ? alloc_units * 2 : 64;
+	      offsets = (bfd_uint64_t *)
+		bfd_realloc (unit_offsets, sizeof (*offsets) * alloc_units);
+	      if (offsets == NULL)
+		{
+		  if (unit_offsets)
+		    free (unit_offsets);
+		  return FALSE;
+		}
+	      unit_offsets = offsets;
+	    }
+	  unit_offsets[num_units++] = ptr - stash->info_ptr_memory;
+	}
+      ptr += length_size + length;
+    }
+
+  for (i = 0, n = 0; i < stash->num_info_aranges; i++)
+    if (num_units != 0
+	&& bsearch (&stash->info_aranges[i].info_offset, unit_offsets,
+		    num_units, sizeof (*unit_offsets),
+		    compare_info_offsets) != NULL)
+      stash->info_aranges[n++] = stash->info_aranges[i];
+  stash->num_info_aranges = n;
+
+  if (unit_offsets)
+    free (unit_offsets);
+  return TRUE;
+}
+
+/* Read STASH's info aranges from .debug_aranges or, failing that,
+   .gdb_index.  ABFD is the bfd being looked up.  */
+
+static void
+stash_read_info_aranges (struct dwarf2_debug *stash, bfd *abfd)
+{
+  bfd *debug_bfd = stash->bfd_ptr;
+  const struct dwarf_debug_section *aranges_names;
+  asection *msec;
+  bfd_byte *contents;
+  void *map_addr;
+  bfd_size_type map_len;
+  unsigned int alloc = 0;
+  bfd_boolean ok;
+  bfd_vma max_high;
+  unsigned int i;
+
+  stash->info_aranges_status = STASH_INFO_ARANGES_NONE;
+
+  /* The index holds final addresses, and its offsets are relative to a
+     single .debug_info section.  */
+  if ((abfd->flags & (EXEC_P | DYNAMIC)) == 0
+      || bfd_get_flavour (debug_bfd) != bfd_target_elf_flavour
+      || find_debug_info (debug_bfd, stash->debug_sections,
+			  find_debug_info (debug_bfd, stash->debug_sections,
+					   NULL)) != NULL)
+    return;
+
+  aranges_names = &stash->debug_sections[debug_aranges];
+  msec = bfd_get_section_by_name (debug_bfd, aranges_names->uncompressed_name);
+  if (msec == NULL && aranges_names->compressed_name != NULL)
+    msec = bfd_get_section_by_name (debug_bfd,
+				    aranges_names->compressed_name);
+  if (msec == NULL)
+    msec = bfd_get_section_by_name (debug_bfd, ".gdb_index");
+  if (msec == NULL
+      || !bfd_borrow_section_contents (debug_bfd, msec, &contents,
+				       &map_addr, &map_len)
+      || contents == NULL)
+    return;
+
+  if (strcmp (msec->name, ".gdb_index") == 0)
+    ok = read_gdb_index_aranges (stash, &alloc, contents,
+				 bfd_get_section_size (msec));
+  else
+    ok = read_debug_aranges (stash, &alloc, contents,
+			     msec->rawsize ? msec->rawsize : msec->size);
+  bfd_return_borrowed_contents (contents, map_addr, map_len);
+
+  if (ok)
+    ok = stash_check_info_aranges (stash);
+  if (!ok || stash->num_info_aranges == 0)
+    {
+      if (stash->info_aranges)
+	free (stash->info_aranges);
+      stash->info_aranges = NULL;
+      stash->num_info_aranges = 0;
+      return;
+    }
+
+  qsort (stash->info_aranges, stash->num_info_aranges,
+	 sizeof (struct info_arange), compare_info_aranges);
+  max_high = 0;
+  for (i = 0; i < stash->num_info_aranges; i++)
+    {
+      if (stash->info_aranges[i].high > max_high)
+	max_high = stash->info_aranges[i].high;
+      stash->info_aranges[i].max_high = max_high;
+    }
+  stash->info_aranges_status = STASH_INFO_ARANGES_READ;
+}
+
+/* Return the index in STASH->units_read_early at which INFO_PTR_UNIT
+   is or would be.  */
+
+static unsigned int
+stash_find_unit_read_early (struct dwarf2_debug *stash,
+			    bfd_byte *info_ptr_unit)
+{
+  unsigned int low = 0;
+  unsigned int high = stash->num_units_read_early;
+
+  while (low < high)
+    {
+      unsigned int mid = (low + high) / 2;
+
+      if (stash->units_read_early[mid] < info_ptr_unit)
+	low = mid + 1;
+      else
+	high = mid;
+    }
+  return low;
+}
+
+/* Return TRUE if the comp. unit at INFO_PTR_UNIT was read through
+   STASH's info aranges.  */
+
+static bfd_boolean
+stash_unit_read_early (struct dwarf2_debug *stash, bfd_byte *info_ptr_unit)
+{
+  unsigned int i;
+
+  if (stash->num_units_read_early == 0)
+    return FALSE;
+  i = stash_find_unit_read_early (stash, info_ptr_unit);
+  return (i < stash->num_units_read_early
+	  && stash->units_read_early[i] == info_ptr_unit);
+}
+
+/* Read the comp. units that STASH's info aranges say contain ADDR and
+   that have not been read yet.  ABFD is the bfd being looked up.  */
+
+static bfd_boolean
+stash_read_units_for_address (struct dwarf2_debug *stash, bfd *abfd,
+			      bfd_vma addr)
+{
+  struct info_arange *aranges;
+  unsigned int low, high, mid;
+
+  if (stash->info_ptr >= stash->info_ptr_end)
+    return TRUE;
+
+  if (stash->info_aranges_status == STASH_INFO_ARANGES_UNREAD)
+    stash_read_info_aranges (stash, abfd);
+  if (stash->info_aranges_status != STASH_INFO_ARANGES_READ)
+    return TRUE;
+
+  aranges = stash->info_aranges;
+  low = 0;
+  high = stash->num_info_aranges;
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      if (addr < aranges[mid].max_high)
+	high = mid;
+      else
+	low = mid + 1;
+    }
+
+  for (; low < stash->num_info_aranges && aranges[low].low <= addr; low++)
+    {
+      bfd_byte *info_ptr_unit;
+      struct comp_unit *each;
+      unsigned int offset_size, length_size, i;
+      bfd_vma length;
+
+      if (addr >= aranges[low].high)
+	continue;
+
+      /* Units before info_ptr have been read in order.  */
+      info_ptr_unit = stash->info_ptr_memory + aranges[low].info_offset;
+      if (info_ptr_unit < stash->info_ptr)
+	continue;
+      i = stash_find_unit_read_early (stash, info_ptr_unit);
+      if (i < stash->num_units_read_early
+	  && stash->units_read_early[i] == info_ptr_unit)
+	continue;
+
+      length = read_unit_length (stash->bfd_ptr, info_ptr_unit,
+				 &offset_size, &length_size);
+      each = parse_comp_unit (stash, length, info_ptr_unit, offset_size,
+			      info_ptr_unit + length_size);
+      if (each == NULL)
+	/* Leave the damage for the walk of .debug_info to find.  */
+	continue;
+
+      if (stash->num_units_read_early >= stash->alloc_units_read_early)
+	{
+	  unsigned int alloc = stash->alloc_units_read_early * 2;
+	  bfd_byte **units;
+
+	  if (alloc == 0)
+	    alloc = 16;
+	  units = (bfd_byte **)
+	    bfd_realloc (stash->units_read_early, sizeof (*units) * alloc);
+	  if (units == NULL)
+	    return FALSE;
+	  stash->units_read_early = units;
+	  stash->alloc_units_read_early = alloc;
+	}
+      memmove (stash->units_read_early + i + 1, stash->units_read_early + i,
+	       (stash->num_units_read_early - i) * sizeof (bfd_byte *));
+      stash->units_read_early[i] = info_ptr_unit;
+      stash->num_units_read_early++;
+
+      if (!stash_add_comp_unit (stash, each))
+	return FALSE;
+    }
+
+  return TRUE;
+}
+
+/* Find the line for ADDR in the NUM_UNITS comp. units in UNITS, which
+   are those that may contain it, and set the output parameters as
+   _bfd_dwarf2_find_nearest_line does.  If DECODE, decode the units'
+   line info as needed and remember any inlined function found in
+   STASH.  Otherwise, the line info must have been decoded already,
+   and neither STASH nor the units are changed.  Return TRUE if a line
+   was found.  */
+
+static bfd_boolean
+find_nearest_line_in_units (struct dwarf2_debug *stash,
+			    struct comp_unit **units,
+			    unsigned int num_units,
+			    bfd_vma addr,
+			    bfd_boolean decode,
+			    const char **filename_ptr,
+			    const char **functionname_ptr,
+			    unsigned int *linenumber_ptr,
+			    unsigned int *discriminator_ptr)
+{
+  bfd_vma min_range = (bfd_vma) -1;
+  const char * local_filename = NULL;
+  const char * local_functionname = NULL;
+  unsigned int local_linenumber = 0;
+  unsigned int local_discriminator = 0;
+  unsigned int i;
+
+  for (i = 0; i < num_units; i++)
+    {
+      struct comp_unit *each = units[i];
+      bfd_vma range = (bfd_vma) -1;
+      bfd_boolean found;
+
+      if (!(each->arange.high == 0
+	    || comp_unit_contains_address (each, addr)))
+	continue;
+
+      if (decode)
+	range = comp_unit_find_nearest_line (each, addr,
+					     & local_filename,
+					     & local_functionname,
+					     & local_linenumber,
+					     & local_discriminator,
+					     stash);
+      else if (!each->error && each->line_table != NULL)
+	{
+	  struct funcinfo *function;
+
+	  range = comp_unit_lookup_address (each, addr, &function,
+					    & local_filename,
+					    & local_functionname,
+					    & local_linenumber,
+					    & local_discriminator);
+	}
+      else
+	range = 0;
+      found = range != 0;
+
+      if (found)
+	{
+	  /* PRs 15935 15994: Bogus debug information may have provided us
+	     with an erroneous match.  We attempt to counter this by
+	     selecting the match that has the smallest address range
+	     associated with it.  (We are assuming that corrupt debug info
+	     will tend to result in extra large address ranges rather than
+	     extra small ranges).
+
+	     This does mean that we scan through all of the CUs associated
+	     with the bfd each time this function is called.  But this does
+	     have the benefit of producing consistent results every time the
+	     function is called.  */
+	  if (range <= min_range)
+	    {
+	      if (filename_ptr && local_filename)
+		* filename_ptr = local_filename;
+	      if (functionname_ptr && local_functionname)
+		* functionname_ptr = local_functionname;
+	      if (discriminator_ptr && local_discriminator)
+		* discriminator_ptr = local_discriminator;
+	      if (local_linenumber)
+		* linenumber_ptr = local_linenumber;
+	      min_range = range;
+	    }
+	}
+    }
+
+  return * linenumber_ptr != 0;
+}
+
+/* Read the comp. unit at STASH->info_ptr and advance past it.  Return
+   the unit, or NULL if it is empty or was read already through the
+   info aranges.  Set *DAMAGED if the unit cannot be read or added to
+   the list of units; the rest of .debug_info should not be trusted.  */
+
+static struct comp_unit *
+stash_read_next_comp_unit (struct dwarf2_debug *stash,
+			   const struct dwarf_debug_section *debug_sections,
+			   bfd_boolean *damaged)
+{
+  struct comp_unit *each = NULL;
+  bfd_vma length;
+  unsigned int offset_size;
+  unsigned int length_size;
+  bfd_byte *info_ptr_unit = stash->info_ptr;
+
+  length = read_unit_length (stash->bfd_ptr, stash->info_ptr,
+			     &offset_size, &length_size);
+  stash->info_ptr += length_size;
+
+  if (length == 0)
+    return NULL;
+
+  /* Units found through the address index are on the list already.  */
+  if (!stash_unit_read_early (stash, info_ptr_unit))
+    {
+      each = parse_comp_unit (stash, length, info_ptr_unit,
+			      offset_size, stash->info_ptr);
+      if (!each)
+	{
+	  /* The dwarf information is damaged, don't trust it any
+	     more.  */
+	  *damaged = TRUE;
+	  return NULL;
+	}
+    }
+  stash->info_ptr += length;
+
+  if (each != NULL && !stash_add_comp_unit (stash, each))
+    {
+      *damaged = TRUE;
+      return NULL;
+    }
+
+  if ((bfd_vma) (stash->info_ptr - stash->sec_info_ptr)
+      == stash->sec->size)
+    {
+      stash->sec = find_debug_info (stash->bfd_ptr, debug_sections,
+				    stash->sec);
+      stash->sec_info_ptr = stash->info_ptr;
+    }
+
+  return each;
+}
+
 /* Find the source code location of SYMBOL.  If SYMBOL is NULL
    then find the nearest source code location corresponding to
    the address SECTION + OFFSET.
@@ -3708,51 +4946,18 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
     }
   else
     {
-      bfd_vma min_range = (bfd_vma) -1;
-      const char * local_filename = NULL;
-      const char * local_functionname = NULL;
-      unsigned int local_linenumber = 0;
-      unsigned int local_discriminator = 0;
+      unsigned int num_units;
 
-      for (each = stash->all_comp_units; each; each = each->next_unit)
-	{
-	  bfd_vma range = (bfd_vma) -1;
+      /* Read the units that the address index says contain ADDR
+	 before any others, then only try the units that may contain
+	 ADDR, in the same order as a walk of all_comp_units would.  */
+      if (!stash_read_units_for_address (stash, abfd, addr)
+	  || !stash_find_units_for_address (stash, addr, &num_units))
+	goto done;
 
-	  found = ((each->arange.high == 0
-		    || comp_unit_contains_address (each, addr))
-		   && (range = comp_unit_find_nearest_line (each, addr,
-							    & local_filename,
-							    & local_functionname,
-							    & local_linenumber,
-							    & local_discriminator,
-							    stash)) != 0);
-	  if (found)
-	    {
-	      /* PRs 15935 15994: Bogus debug information may have provided us
-		 with an erroneous match.  We attempt to counter this by
-		 selecting the match that has the smallest address range
-		 associated with it.  (We are assuming that corrupt debug info
-		 will tend to result in extra large address ranges rather than
-		 extra small ranges).
-
-		 This does mean that we scan through all of the CUs associated
-		 with the bfd each time this function is called.  But this does
-		 have the benefit of producing consistent results every time the
-		 function is called.  */
-	      if (range <= min_range)
-		{
-		  if (filename_ptr && local_filename)
-		    * filename_ptr = local_filename;
-		  if (functionname_ptr && local_functionname)
-		    * functionname_ptr = local_functionname;
-		  if (discriminator_ptr && local_discriminator)
-		    * discriminator_ptr = local_discriminator;
-		  if (local_linenumber)
-		    * linenumber_ptr = local_linenumber;
-		  min_range = range;
-		}
-	    }
-	}
+      find_nearest_line_in_units (stash, stash->candidate_units, num_units,
+				  addr, TRUE, filename_ptr, functionname_ptr,
+				  linenumber_ptr, discriminator_ptr);
 
       if (* linenumber_ptr)
 	{
@@ -3771,97 +4976,39 @@ _bfd_dwarf2_find_nearest_line (bfd *abfd,
   /* Read each remaining comp. units checking each as they are read.  */
   while (stash->info_ptr < stash->info_ptr_end)
     {
-      bfd_vma length;
-      unsigned int offset_size = addr_size;
-      bfd_byte *info_ptr_unit = stash->info_ptr;
-
-      length = read_4_bytes (stash->bfd_ptr, stash->info_ptr);
-      /* A 0xffffff length is the DWARF3 way of indicating
-	 we use 64-bit offsets, instead of 32-bit offsets.  */
-      if (length == 0xffffffff)
-	{
-	  offset_size = 8;
-	  length = read_8_bytes (stash->bfd_ptr, stash->info_ptr + 4);
-	  stash->info_ptr += 12;
-	}
-      /* A zero length is the IRIX way of indicating 64-bit offsets,
-	 mostly because the 64-bit length will generally fit in 32
-	 bits, and the endianness helps.  */
-      else if (length == 0)
-	{
-	  offset_size = 8;
-	  length = read_4_bytes (stash->bfd_ptr, stash->info_ptr + 4);
-	  stash->info_ptr += 8;
-	}
-      /* In the absence of the hints above, we assume 32-bit DWARF2
-	 offsets even for targets with 64-bit addresses, because:
-	   a) most of the time these targets will not have generated
-	      more than 2Gb of debug info and so will not need 64-bit
-	      offsets,
-	 and
-	   b) if they do use 64-bit offsets but they are not using
-	      the size hints that are tested for above then they are
-	      not conforming to the DWARF3 standard anyway.  */
-      else if (addr_size == 8)
-	{
-	  offset_size = 4;
-	  stash->info_ptr += 4;
-	}
-      else
-	stash->info_ptr += 4;
-
-      if (length > 0)
-	{
-	  each = parse_comp_unit (stash, length, info_ptr_unit,
-				  offset_size);
-	  if (!each)
-	    /* The dwarf information is damaged, don't trust it any
-	       more.  */
-	    break;
-	  stash->info_ptr += length;
-
-	  if (stash->all_comp_units)
-	    stash->all_comp_units->prev_unit = each;
-	  else
-	    stash->last_comp_unit = each;
-
-	  each->next_unit = stash->all_comp_units;
-	  stash->all_comp_units = each;
-
-	  /* DW_AT_low_pc and DW_AT_high_pc are optional for
-	     compilation units.  If we don't have them (i.e.,
-	     unit->high == 0), we need to consult the line info table
-	     to see if a compilation unit contains the given
-	     address.  */
-	  if (do_line)
-	    found = (((symbol->flags & BSF_FUNCTION) == 0
-		      || each->arange.high == 0
-		      || comp_unit_contains_address (each, addr))
-		     && comp_unit_find_line (each, symbol, addr,
-					     filename_ptr,
-					     linenumber_ptr,
-					     stash));
-	  else
-	    found = ((each->arange.high == 0
-		      || comp_unit_contains_address (each, addr))
-		     && comp_unit_find_nearest_line (each, addr,
-						     filename_ptr,
-						     functionname_ptr,
-						     linenumber_ptr,
-						     discriminator_ptr,
-						     stash)) > 0;
-
-	  if ((bfd_vma) (stash->info_ptr - stash->sec_info_ptr)
-	      == stash->sec->size)
-	    {
-	      stash->sec = find_debug_info (stash->bfd_ptr, debug_sections,
-					    stash->sec);
-	      stash->sec_info_ptr = stash->info_ptr;
-	    }
+      bfd_boolean damaged = FALSE;
 
-	  if (found)
-	    goto done;
-	}
+      each = stash_read_next_comp_unit (stash, debug_sections, &damaged);
+      if (damaged)
+	break;
+      if (each == NULL)
+	continue;
+
+      /* DW_AT_low_pc and DW_AT_high_pc are optional for
+	 compilation units.  If we don't have them (i.e.,
+	 unit->high == 0), we need to consult the line info table
+	 to see if a compilation unit contains the given
+	 address.  */
+      if (do_line)
+	found = (((symbol->flags & BSF_FUNCTION) == 0
+		  || each->arange.high == 0
+		  || comp_unit_contains_address (each, addr))
+		 && comp_unit_find_line (each, symbol, addr,
+					 filename_ptr,
+					 linenumber_ptr,
+					 stash));
+      else
+	found = ((each->arange.high == 0
+		  || comp_unit_contains_address (each, addr))
+		 && comp_unit_find_nearest_line (each, addr,
+						 filename_ptr,
+						 functionname_ptr,
+						 linenumber_ptr,
+						 discriminator_ptr,
+						 stash)) > 0;
+
+      if (found)
+	goto done;
     }
 
  done:
@@ -3898,6 +5045,131 @@ _bfd_dwarf2_find_inliner_info (bfd *abfd ATTRIBUTE_UNUSED,
   return FALSE;
 }
 
+/* Read and decode all the DWARF2 info of ABFD, and build every lookup
+   table, so that _bfd_dwarf2_find_nearest_lines can then be called
+   from several threads at once.  ABFD must be an executable or shared
+   library, since the sections of a relocatable file are placed anew
+   for each lookup.  SYMBOLS and DEBUG_SECTIONS are as for
+   _bfd_dwarf2_find_nearest_line.  */
+
+bfd_boolean
+_bfd_dwarf2_prepare_concurrent_lookups (bfd *abfd,
+					asymbol **symbols,
+					const struct dwarf_debug_section *debug_sections,
+					void **pinfo)
+{
+  struct dwarf2_debug *stash;
+  struct comp_unit *each;
+
+  if ((abfd->flags & (EXEC_P | DYNAMIC)) == 0)
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      return FALSE;
+    }
+
+  if (! _bfd_dwarf2_slurp_debug_info (abfd, NULL, debug_sections,
+				      symbols, pinfo, FALSE))
+    return FALSE;
+
+  stash = (struct dwarf2_debug *) *pinfo;
+  if (stash->concurrent_lookups)
+    return TRUE;
+
+  /* With no dwarf2 info there is nothing to look up; the lookups will
+     all fail.  */
+  if (! stash->info_ptr)
+    {
+      stash->concurrent_lookups = TRUE;
+      return TRUE;
+    }
+
+  while (stash->info_ptr < stash->info_ptr_end)
+    {
+      bfd_boolean damaged = FALSE;
+
+      stash_read_next_comp_unit (stash, debug_sections, &damaged);
+      if (damaged)
+	break;
+    }
+
+  for (each = stash->all_comp_units; each; each = each->next_unit)
+    if (comp_unit_maybe_decode_line_info (each, stash))
+      {
+	unsigned int i;
+
+	for (i = 0; i < each->line_table->num_sequences; i++)
+	  build_line_info_table (each->line_table,
+				 &each->line_table->sequences[i]);
+	if (each->lookup_funcinfo_table == NULL
+	    && !build_lookup_funcinfo_table (each))
+	  return FALSE;
+      }
+
+  if (!stash_sort_unit_ranges (stash))
+    return FALSE;
+  stash_prune_rangeless_units (stash);
+
+  stash->concurrent_lookups = TRUE;
+  return TRUE;
+}
+
+/* Find the source code location of each of the COUNT addresses in
+   LOOKUPS, as _bfd_dwarf2_find_nearest_line would, setting the other
+   fields of each entry; they are NULL or zero where nothing is found.
+   The addresses are VMAs.  INFO must have been prepared by
+   _bfd_dwarf2_prepare_concurrent_lookups.  This does not change INFO,
+   so any number of threads may call it at once, but not while another
+   thread calls _bfd_dwarf2_find_nearest_line or the like on the same
+   bfd.  No inliner info is kept for _bfd_dwarf2_find_inliner_info.  */
+
+bfd_boolean
+_bfd_dwarf2_find_nearest_lines (void *info,
+				struct bfd_line_lookup *lookups,
+				bfd_size_type count)
+{
+  struct dwarf2_debug *stash = (struct dwarf2_debug *) info;
+  struct comp_unit **units = NULL;
+  unsigned int alloc_units = 0;
+  bfd_boolean ret = TRUE;
+  bfd_size_type i;
+
+  if (stash == NULL || !stash->concurrent_lookups)
+    {
+      bfd_set_error (bfd_error_invalid_operation);
+      return FALSE;
+    }
+
+  for (i = 0; i < count; i++)
+    {
+      struct bfd_line_lookup *lookup = &lookups[i];
+      unsigned int num_units;
+
+      lookup->filename = NULL;
+      lookup->functionname = NULL;
+      lookup->line = 0;
+      lookup->discriminator = 0;
+
+      if (! stash->info_ptr)
+	continue;
+
+      if (!find_units_for_address (stash, lookup->address, &units,
+				   &alloc_units, &num_units))
+	{
+	  ret = FALSE;
+	  break;
+	}
+
+      find_nearest_line_in_units (stash, units, num_units,
+				  lookup->address, FALSE,
+				  &lookup->filename, &lookup->functionname,
+				  &lookup->line, &lookup->discriminator);
+    }
+
+  if (units != NULL)
+    free (units);
+  return ret;
+}
+
 void
 _bfd_dwarf2_cleanup_debug_info (bfd *abfd, void **pinfo)
 {
@@ -3959,24 +5231,28 @@ _bfd_dwarf2_cleanup_debug_info (bfd *abfd, void **pinfo)
 	}
     }
 
-  if (stash->dwarf_abbrev_buffer)
-    free (stash->dwarf_abbrev_buffer);
-  if (stash->dwarf_line_buffer)
-    free (stash->dwarf_line_buffer);
-  if (stash->dwarf_str_buffer)
-    free (stash->dwarf_str_buffer);
-  if (stash->dwarf_ranges_buffer)
-    free (stash->dwarf_ranges_buffer);
-  if (stash->info_ptr_memory)
-    free (stash->info_ptr_memory);
+  free_section_buffer (stash, stash->dwarf_abbrev_buffer);
+  free_section_buffer (stash, stash->dwarf_line_buffer);
+  free_section_buffer (stash, stash->dwarf_str_buffer);
+  free_section_buffer (stash, stash->dwarf_ranges_buffer);
+  free_section_buffer (stash, stash->info_ptr_memory);
   if (stash->close_on_cleanup)
     bfd_close (stash->bfd_ptr);
-  if (stash->alt_dwarf_str_buffer)
-    free (stash->alt_dwarf_str_buffer);
-  if (stash->alt_dwarf_info_buffer)
-    free (stash->alt_dwarf_info_buffer);
+  free_section_buffer (stash, stash->alt_dwarf_str_buffer);
+  free_section_buffer (stash, stash->alt_dwarf_info_buffer);
+  BFD_ASSERT (stash->borrowed_sections == NULL);
   if (stash->sec_vma)
     free (stash->sec_vma);
+  if (stash->unit_ranges)
+    free (stash->unit_ranges);
+  if (stash->rangeless_units)
+    free (stash->rangeless_units);
+  if (stash->candidate_units)
+    free (stash->candidate_units);
+  if (stash->info_aranges)
+    free (stash->info_aranges);
+  if (stash->units_read_early)
+    free (stash->units_read_early);
   if (stash->adjusted_sections)
     free (stash->adjusted_sections);
   if (stash->alt_bfd_ptr)
@@ -511,6 +511,15 @@ struct elf_link_hash_table
   /* Used by eh_frame code when editing .eh_frame.  */
   struct eh_frame_hdr_info eh_info;
 
+  /* Sections marked by the gc mark phase whose relocs have yet to be
+     scanned, used as a stack by _bfd_elf_gc_mark.  */
+  asection **gc_mark_stack;
+  unsigned int gc_mark_stack_count;
+  unsigned int gc_mark_stack_size;
+
+  /* TRUE while _bfd_elf_gc_mark is emptying gc_mark_stack.  */
+  bfd_boolean gc_mark_active;
+
   /* A linked list of local symbols to be added to .dynsym.  */
   struct elf_link_local_dynamic_entry *dynlocal;
 
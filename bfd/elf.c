@@ -370,8 +370,12 @@ bfd_elf_get_elf_syms (bfd *ibfd,
 {
   Elf_Internal_Shdr *shndx_hdr;
   void *alloc_ext;
+  void *ext_map_addr;
+  bfd_size_type ext_map_len;
   const bfd_byte *esym;
   Elf_External_Sym_Shndx *alloc_extshndx;
+  void *shndx_map_addr;
+  bfd_size_type shndx_map_len;
   Elf_External_Sym_Shndx *shndx;
   Elf_Internal_Sym *alloc_intsym;
   Elf_Internal_Sym *isym;
@@ -400,14 +404,31 @@ bfd_elf_get_elf_syms (bfd *ibfd,
   extsym_size = bed->s->sizeof_sym;
   amt = symcount * extsym_size;
   pos = symtab_hdr->sh_offset + symoffset * extsym_size;
+  ext_map_addr = NULL;
+  ext_map_len = 0;
+  shndx_map_addr = NULL;
+  shndx_map_len = 0;
   if (extsym_buf == NULL)
     {
-      alloc_ext = bfd_malloc2 (symcount, extsym_size);
+      /* The external symbols are only needed while they are swapped
+	 in, so borrow them from the file rather than copying them.  */
+      if (amt / extsym_size != symcount)
+	{
+	  bfd_set_error (bfd_error_no_memory);
+	  intsym_buf = NULL;
+	  goto out;
+	}
+      alloc_ext = bfd_borrow_file_range (ibfd, pos, amt,
+					 &ext_map_addr, &ext_map_len);
       extsym_buf = alloc_ext;
+      if (extsym_buf == NULL)
+	{
+	  intsym_buf = NULL;
+	  goto out;
+	}
     }
-  if (extsym_buf == NULL
-      || bfd_seek (ibfd, pos, SEEK_SET) != 0
-      || bfd_bread (extsym_buf, amt, ibfd) != amt)
+  else if (bfd_seek (ibfd, pos, SEEK_SET) != 0
+	   || bfd_bread (extsym_buf, amt, ibfd) != amt)
     {
       intsym_buf = NULL;
       goto out;
@@ -421,13 +442,24 @@ bfd_elf_get_elf_syms (bfd *ibfd,
       pos = shndx_hdr->sh_offset + symoffset * sizeof (Elf_External_Sym_Shndx);
       if (extshndx_buf == NULL)
 	{
+	  if (amt / sizeof (Elf_External_Sym_Shndx) != symcount)
+	    {
+	      bfd_set_error (bfd_error_no_memory);
+	      intsym_buf = NULL;
+	      goto out;
+	    }
 	  alloc_extshndx = (Elf_External_Sym_Shndx *)
-              bfd_malloc2 (symcount, sizeof (Elf_External_Sym_Shndx));
+	    bfd_borrow_file_range (ibfd, pos, amt,
+				   &shndx_map_addr, &shndx_map_len);
 	  extshndx_buf = alloc_extshndx;
+	  if (extshndx_buf == NULL)
+	    {
+	      intsym_buf = NULL;
+	      goto out;
+	    }
 	}
-      if (extshndx_buf == NULL
-	  || bfd_seek (ibfd, pos, SEEK_SET) != 0
-	  || bfd_bread (extshndx_buf, amt, ibfd) != amt)
+      else if (bfd_seek (ibfd, pos, SEEK_SET) != 0
+	       || bfd_bread (extshndx_buf, amt, ibfd) != amt)
 	{
 	  intsym_buf = NULL;
 	  goto out;
@@ -463,9 +495,10 @@ bfd_elf_get_elf_syms (bfd *ibfd,
 
  out:
   if (alloc_ext != NULL)
-    free (alloc_ext);
+    bfd_return_borrowed_contents (alloc_ext, ext_map_addr, ext_map_len);
   if (alloc_extshndx != NULL)
-    free (alloc_extshndx);
+    bfd_return_borrowed_contents (alloc_extshndx,
+				  shndx_map_addr, shndx_map_len);
 
   return intsym_buf;
 }
@@ -7841,6 +7874,40 @@ _bfd_elf_find_inliner_info (bfd *abfd,
   return found;
 }
 
+/* Read all the DWARF debugging information of ABFD for
+   bfd_elf_find_nearest_lines.  */
+
+bfd_boolean
+bfd_elf_prepare_line_lookups (bfd *abfd, asymbol **symbols)
+{
+  if (abfd->xvec->flavour != bfd_target_elf_flavour)
+    {
+      bfd_set_error (bfd_error_wrong_format);
+      return FALSE;
+    }
+
+  return _bfd_dwarf2_prepare_concurrent_lookups
+    (abfd, symbols, dwarf_debug_sections,
+     &elf_tdata (abfd)->dwarf2_find_line_info);
+}
+
+/* Look up the source location of each of the COUNT addresses in
+   LOOKUPS.  This may be called from several threads at once.  */
+
+bfd_boolean
+bfd_elf_find_nearest_lines (bfd *abfd, struct bfd_line_lookup *lookups,
+			    bfd_size_type count)
+{
+  if (abfd->xvec->flavour != bfd_target_elf_flavour)
+    {
+      bfd_set_error (bfd_error_wrong_format);
+      return FALSE;
+    }
+
+  return _bfd_dwarf2_find_nearest_lines
+    (elf_tdata (abfd)->dwarf2_find_line_info, lookups, count);
+}
+
 int
 _bfd_elf_sizeof_headers (bfd *abfd, struct bfd_link_info *info)
 {
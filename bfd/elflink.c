@@ -4926,6 +4926,66 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
   return h;
 }
 
+/* Add to TABLE the names under which _bfd_elf_archive_symbol_lookup
+   may find the versioned archive map entry INDX of ABFD.  */
+
+static bfd_boolean
+elf_link_armap_index_add_versions (struct bfd_hash_table *table,
+				   bfd *abfd, symindex indx)
+{
+  const char *name;
+  const char *p;
+  char *copy;
+  size_t len, first;
+  bfd_boolean ret;
+
+  name = bfd_ardata (abfd)->symdefs[indx].name;
+  p = strchr (name, ELF_VER_CHR);
+  if (p == NULL || p[1] != ELF_VER_CHR)
+    return TRUE;
+
+  len = strlen (name);
+  copy = (char *) bfd_malloc (len);
+  if (copy == NULL)
+    return FALSE;
+
+  first = p - name + 1;
+  memcpy (copy, name, first);
+  memcpy (copy + first, name + first + 1, len - first);
+  ret = _bfd_link_armap_index_add (table, copy, TRUE, indx);
+  copy[first - 1] = '\0';
+  if (ret)
+    ret = _bfd_link_armap_index_add (table, copy, TRUE, indx);
+  free (copy);
+  return ret;
+}
+
+/* Return TRUE if NAME is one of the names under which
+   elf_link_armap_index_add_versions and _bfd_link_armap_index_init
+   index the archive map name ARNAME.  */
+
+static bfd_boolean
+elf_link_armap_index_name_p (const char *name, const char *arname)
+{
+  const char *p;
+  size_t first;
+
+  if (strcmp (name, arname) == 0)
+    return TRUE;
+
+  p = strchr (arname, ELF_VER_CHR);
+  if (p == NULL || p[1] != ELF_VER_CHR)
+    return FALSE;
+
+  first = p - arname;
+  if (strncmp (name, arname, first) != 0)
+    return FALSE;
+  if (name[first] == '\0')
+    return TRUE;
+  return (name[first] == ELF_VER_CHR
+	  && strcmp (name + first + 1, arname + first + 2) == 0);
+}
+
 /* Add symbols from an ELF archive file to the linker hash table.  We
    don't use _bfd_generic_link_add_archive_symbols because we need to
    handle versioned symbols.
@@ -4937,19 +4997,26 @@ _bfd_elf_archive_symbol_lookup (bfd *abfd,
    object file.
 
    Unfortunately, we do have to make multiple passes over the symbol
-   table until nothing further is resolved.  */
+   table until nothing further is resolved.  Only the first pass looks
+   at every archive map entry, though.  Once an included object adds
+   undefined symbols, an index from names to archive map entries is
+   used to pick out the entries those symbols may resolve, and later
+   passes look only at those.  */
 
 static bfd_boolean
 elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 {
   symindex c;
   unsigned char *included = NULL;
+  unsigned char *pending;
   carsym *symdefs;
   bfd_boolean loop;
   bfd_size_type amt;
   const struct elf_backend_data *bed;
   struct elf_link_hash_entry * (*archive_symbol_lookup)
     (bfd *, struct bfd_link_info *, const char *);
+  struct bfd_hash_table armap_index;
+  bfd_boolean can_index, indexed;
 
   if (! bfd_has_map (abfd))
     {
@@ -4962,46 +5029,62 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 
   /* Keep track of all symbols we know to be already defined, and all
      files we know to be already included.  This is to speed up the
-     second and subsequent passes.  */
+     second and subsequent passes.  Also keep track of the symbols
+     that need looking at in the next pass.  */
   c = bfd_ardata (abfd)->symdef_count;
   if (c == 0)
     return TRUE;
   amt = c;
-  amt *= sizeof (*included);
+  amt *= 2 * sizeof (*included);
   included = (unsigned char *) bfd_zmalloc (amt);
   if (included == NULL)
     return FALSE;
+  pending = included + c;
+  memset (pending, 1, c);
 
   symdefs = bfd_ardata (abfd)->symdefs;
   bed = get_elf_backend_data (abfd);
   archive_symbol_lookup = bed->elf_backend_archive_symbol_lookup;
 
+  /* We only know which names a backend specific lookup function
+     might try, if it is the default one.  */
+  can_index = archive_symbol_lookup == _bfd_elf_archive_symbol_lookup;
+  indexed = FALSE;
+
   do
     {
       file_ptr last;
       symindex i;
       carsym *symdef;
-      carsym *symdefend;
+      bfd_boolean retry;
+      struct bfd_link_hash_entry *pass_undefs_tail;
 
       loop = FALSE;
+      retry = FALSE;
       last = -1;
+      pass_undefs_tail = info->hash->undefs_tail;
+      info->archive_passes++;
 
-      symdef = symdefs;
-      symdefend = symdef + c;
-      for (i = 0; symdef < symdefend; symdef++, i++)
+      for (i = 0; i < c; i++)
 	{
 	  struct elf_link_hash_entry *h;
 	  bfd *element;
 	  struct bfd_link_hash_entry *undefs_tail;
 	  symindex mark;
 
+	  if (!pending[i])
+	    continue;
+	  if (can_index)
+	    pending[i] = 0;
 	  if (included[i])
 	    continue;
+	  symdef = symdefs + i;
 	  if (symdef->file_offset == last)
 	    {
 	      included[i] = TRUE;
 	      continue;
 	    }
+	  info->archive_lookups++;
 
 	  h = archive_symbol_lookup (abfd, info, symdef->name);
 	  if (h == (struct elf_link_hash_entry *) 0 - 1)
@@ -5032,6 +5115,16 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	      if (h->root.type != bfd_link_hash_undefweak)
 		/* Symbol must be defined.  Don't check it again.  */
 		included[i] = TRUE;
+	      else if (can_index
+		       && !elf_link_armap_index_name_p (h->root.root.string,
+							symdef->name))
+		{
+		  /* We followed an indirect or warning symbol, so the
+		     index will not notice if H becomes undefined.
+		     Check this entry again on any later pass.  */
+		  pending[i] = 1;
+		  retry = TRUE;
+		}
 	      continue;
 	    }
 
@@ -5053,13 +5146,33 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 
 	  /* If there are any new undefined symbols, we need to make
 	     another pass through the archive in order to see whether
-	     they can be defined.  FIXME: This isn't perfect, because
-	     common symbols wind up on undefs_tail and because an
-	     undefined symbol which is defined later on in this pass
-	     does not require another pass.  This isn't a bug, but it
-	     does make the code less efficient than it could be.  */
+	     they can be defined, unless we can tell that they can only
+	     be defined by an entry later in this pass.  Common symbols
+	     wind up on undefs_tail too, which may cause a needless
+	     pass.  */
 	  if (undefs_tail != info->hash->undefs_tail)
-	    loop = TRUE;
+	    {
+	      if (!can_index)
+		loop = TRUE;
+	      else
+		{
+		  if (!indexed)
+		    {
+		      symindex j;
+
+		      if (!_bfd_link_armap_index_init (&armap_index, abfd))
+			goto error_return;
+		      indexed = TRUE;
+		      for (j = 0; j < c; j++)
+			if (!elf_link_armap_index_add_versions (&armap_index,
+								abfd, j))
+			  goto error_return;
+		    }
+		  if (_bfd_link_armap_index_mark (&armap_index, info,
+						  undefs_tail, pending) <= i)
+		    loop = TRUE;
+		}
+	    }
 
 	  /* Look backward to mark all symbols from this object file
 	     which we have already seen in this pass.  */
@@ -5073,18 +5186,35 @@ elf_link_add_archive_symbols (bfd *abfd, struct bfd_link_info *info)
 	    }
 	  while (symdefs[mark].file_offset == symdef->file_offset);
 
+	  /* Also mark the following symbols from this object file, which
+	     a later pass might otherwise look at without passing over
+	     this entry first.  */
+	  for (mark = i + 1;
+	       mark < c && symdefs[mark].file_offset == symdef->file_offset;
+	       mark++)
+	    included[mark] = TRUE;
+
 	  /* We mark subsequent symbols from this object file as we go
 	     on through the loop.  */
 	  last = symdef->file_offset;
 	}
+
+      /* Entries that followed an indirect symbol only need another
+	 look if some symbol became undefined.  */
+      if (retry && pass_undefs_tail != info->hash->undefs_tail)
+	loop = TRUE;
     }
   while (loop);
 
+  if (indexed)
+    bfd_hash_table_free (&armap_index);
   free (included);
 
   return TRUE;
 
  error_return:
+  if (indexed)
+    bfd_hash_table_free (&armap_index);
   if (included != NULL)
     free (included);
   return FALSE;
@@ -8022,59 +8152,64 @@ elf_link_adjust_relocs (bfd *abfd,
 
 struct elf_link_sort_rela
 {
-  union {
-    bfd_vma offset;
-    bfd_vma sym_mask;
-  } u;
   enum elf_reloc_type_class type;
   /* We use this as an array of size int_rels_per_ext_rel.  */
   Elf_Internal_Rela rela[1];
 };
 
-static int
-elf_link_sort_cmp1 (const void *A, const void *B)
+/* Stably sort the COUNT indices in *PIDX by KEY[index], least
+   significant byte first, using *PTMP as scratch space of the same
+   size.  Bytes which are the same in every key are skipped.  The two
+   buffers may be swapped on return; *PIDX holds the result.  */
+
+static void
+elf_link_radix_sort (size_t **pidx, size_t **ptmp, const bfd_vma *key,
+		     size_t count)
 {
-  const struct elf_link_sort_rela *a = (const struct elf_link_sort_rela *) A;
-  const struct elf_link_sort_rela *b = (const struct elf_link_sort_rela *) B;
-  int relativea, relativeb;
+  size_t counts[sizeof (bfd_vma)][256];
+  size_t *idx = *pidx;
+  size_t *tmp = *ptmp;
+  size_t *t;
+  size_t i;
+  unsigned int b;
 
-  relativea = a->type == reloc_class_relative;
-  relativeb = b->type == reloc_class_relative;
+  if (count < 2)
+    return;
 
-  if (relativea < relativeb)
-    return 1;
-  if (relativea > relativeb)
-    return -1;
-  if ((a->rela->r_info & a->u.sym_mask) < (b->rela->r_info & b->u.sym_mask))
-    return -1;
-  if ((a->rela->r_info & a->u.sym_mask) > (b->rela->r_info & b->u.sym_mask))
-    return 1;
-  if (a->rela->r_offset < b->rela->r_offset)
-    return -1;
-  if (a->rela->r_offset > b->rela->r_offset)
-    return 1;
-  return 0;
-}
+  memset (counts, 0, sizeof (counts));
+  for (i = 0; i < count; i++)
+    {
+      bfd_vma k = key[idx[i]];
 
-static int
-elf_link_sort_cmp2 (const void *A, const void *B)
-{
-  const struct elf_link_sort_rela *a = (const struct elf_link_sort_rela *) A;
-  const struct elf_link_sort_rela *b = (const struct elf_link_sort_rela *) B;
+      for (b = 0; b < sizeof (bfd_vma); b++, k >>= 8)
+	counts[b][k & 0xff]++;
+    }
 
-  if (a->type < b->type)
-    return -1;
-  if (a->type > b->type)
-    return 1;
-  if (a->u.offset < b->u.offset)
-    return -1;
-  if (a->u.offset > b->u.offset)
-    return 1;
-  if (a->rela->r_offset < b->rela->r_offset)
-    return -1;
-  if (a->rela->r_offset > b->rela->r_offset)
-    return 1;
-  return 0;
+  for (b = 0; b < sizeof (bfd_vma); b++)
+    {
+      size_t *c = counts[b];
+      size_t sum, n;
+      unsigned int shift = b * 8;
+      unsigned int j;
+
+      if (c[(key[idx[0]] >> shift) & 0xff] == count)
+	continue;
+
+      for (sum = 0, j = 0; j < 256; j++)
+	{
+	  n = c[j];
+	  c[j] = sum;
+	  sum += n;
+	}
+      for (i = 0; i < count; i++)
+	tmp[c[(key[idx[i]] >> shift) & 0xff]++] = idx[i];
+
+      t = idx;
+      idx = tmp;
+      tmp = t;
+    }
+  *pidx = idx;
+  *ptmp = tmp;
 }
 
 static size_t
@@ -8085,8 +8220,9 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
   asection *rel_dyn;
   bfd_size_type count, size;
   size_t i, ret, sort_elt, ext_size;
-  bfd_byte *sort, *s_non_relative, *p;
-  struct elf_link_sort_rela *sq;
+  bfd_byte *sort, *p;
+  bfd_vma *offset, *key;
+  size_t *idx, *tmp;
   const struct elf_backend_data *bed = get_elf_backend_data (abfd);
   int i2e = bed->s->int_rels_per_ext_rel;
   void (*swap_in) (bfd *, const bfd_byte *, Elf_Internal_Rela *);
@@ -8257,7 +8393,9 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
   count = dynamic_relocs->size / ext_size;
   if (count == 0)
     return 0;
-  sort = (bfd_byte *) bfd_zmalloc (sort_elt * count);
+  sort = (bfd_byte *) bfd_malloc (sort_elt * count
+				  + count * (2 * sizeof (bfd_vma)
+					     + 2 * sizeof (size_t)));
 
   if (sort == NULL)
     {
@@ -8265,6 +8403,10 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 	(info, _("Not enough memory to sort relocations"), 0, abfd, 0, 0);
       return 0;
     }
+  offset = (bfd_vma *) (sort + sort_elt * count);
+  key = offset + count;
+  idx = (size_t *) (key + count);
+  tmp = idx + count;
 
   if (bed->s->arch_size == 32)
     r_sym_mask = ~(bfd_vma) 0xff;
@@ -8296,34 +8438,65 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 
 	    (*swap_in) (abfd, erel, s->rela);
 	    s->type = (*bed->elf_backend_reloc_type_class) (info, o, s->rela);
-	    s->u.sym_mask = r_sym_mask;
 	    p += sort_elt;
 	    erel += ext_size;
 	  }
       }
 
-  qsort (sort, count, sort_elt, elf_link_sort_cmp1);
+#define SORT_RELA(I) ((struct elf_link_sort_rela *) (sort + (I) * sort_elt))
 
-  for (i = 0, p = sort; i < count; i++, p += sort_elt)
+  /* Put the relative relocs first, then sort by symbol and r_offset.
+     Rather than moving the relocs about, sort their indices with a
+     stable radix sort on each key in turn, least significant first.  */
+  ret = 0;
+  for (i = 0; i < count; i++)
     {
-      struct elf_link_sort_rela *s = (struct elf_link_sort_rela *) p;
-      if (s->type != reloc_class_relative)
-	break;
-    }
-  ret = i;
-  s_non_relative = p;
+      struct elf_link_sort_rela *s = SORT_RELA (i);
 
-  sq = (struct elf_link_sort_rela *) s_non_relative;
-  for (; i < count; i++, p += sort_elt)
+      idx[i] = i;
+      offset[i] = s->rela->r_offset;
+      key[i] = s->rela->r_info & r_sym_mask;
+      if (s->type == reloc_class_relative)
+	ret++;
+    }
+  elf_link_radix_sort (&idx, &tmp, offset, count);
+  elf_link_radix_sort (&idx, &tmp, key, count);
+  if (ret != 0 && ret != count)
     {
-      struct elf_link_sort_rela *sp = (struct elf_link_sort_rela *) p;
-      if (((sp->rela->r_info ^ sq->rela->r_info) & r_sym_mask) != 0)
-	sq = sp;
-      sp->u.offset = sq->rela->r_offset;
+      for (i = 0; i < count; i++)
+	key[i] = SORT_RELA (i)->type != reloc_class_relative;
+      elf_link_radix_sort (&idx, &tmp, key, count);
     }
 
-  qsort (s_non_relative, count - ret, sort_elt, elf_link_sort_cmp2);
+  /* Sort the rest by reloc type class, then by the r_offset of the
+     first reloc against the same symbol, then by r_offset.  */
+  if (ret < count)
+    {
+      size_t nrel = count - ret;
+      size_t *nidx = idx + ret;
+      size_t *ntmp = tmp + ret;
+      struct elf_link_sort_rela *sq;
+
+      sq = SORT_RELA (nidx[0]);
+      for (i = 0; i < nrel; i++)
+	{
+	  struct elf_link_sort_rela *sp = SORT_RELA (nidx[i]);
+
+	  if (((sp->rela->r_info ^ sq->rela->r_info) & r_sym_mask) != 0)
+	    sq = sp;
+	  key[nidx[i]] = sq->rela->r_offset;
+	}
+      elf_link_radix_sort (&nidx, &ntmp, offset, nrel);
+      elf_link_radix_sort (&nidx, &ntmp, key, nrel);
+      for (i = 0; i < nrel; i++)
+	key[nidx[i]] = SORT_RELA (nidx[i])->type;
+      elf_link_radix_sort (&nidx, &ntmp, key, nrel);
 
+      if (nidx != idx + ret)
+	memcpy (idx + ret, nidx, nrel * sizeof (*idx));
+    }
+
+  /* Write the relocs out in sorted order.  */
   for (lo = dynamic_relocs->map_head.link_order; lo != NULL; lo = lo->next)
     if (lo->type == bfd_indirect_link_order)
       {
@@ -8333,16 +8506,17 @@ elf_link_sort_relocs (bfd *abfd, struct bfd_link_info *info, asection **psec)
 	erel = o->contents;
 	erelend = o->contents + o->size;
 	/* FIXME: octets_per_byte.  */
-	p = sort + o->output_offset / ext_size * sort_elt;
+	i = o->output_offset / ext_size;
 	while (erel < erelend)
 	  {
-	    struct elf_link_sort_rela *s = (struct elf_link_sort_rela *) p;
-	    (*swap_out) (abfd, s->rela, erel);
-	    p += sort_elt;
+	    (*swap_out) (abfd, SORT_RELA (idx[i])->rela, erel);
+	    i++;
 	    erel += ext_size;
 	  }
       }
 
+#undef SORT_RELA
+
   free (sort);
   *psec = dynamic_relocs;
   return ret;
@@ -11720,24 +11894,49 @@ _bfd_elf_gc_mark_reloc (struct bfd_link_info *info,
   return TRUE;
 }
 
-/* The mark phase of garbage collection.  For a given section, mark
-   it and any sections in this section's group, and all the sections
-   which define symbols to which it refers.  */
+/* Mark SEC and push it on the stack of sections whose relocs are
+   still to be scanned.  */
 
-bfd_boolean
-_bfd_elf_gc_mark (struct bfd_link_info *info,
-		  asection *sec,
-		  elf_gc_mark_hook_fn gc_mark_hook)
+static bfd_boolean
+elf_gc_mark_push (struct bfd_link_info *info, asection *sec)
 {
-  bfd_boolean ret;
-  asection *group_sec, *eh_frame;
+  struct elf_link_hash_table *htab = elf_hash_table (info);
 
   sec->gc_mark = 1;
+  if (htab->gc_mark_stack_count >= htab->gc_mark_stack_size)
+    {
+      unsigned int size;
+      asection **stack;
+
+      size = htab->gc_mark_stack_size * 2;
+      if (size == 0)
+	size = 256;
+      stack = (asection **) bfd_realloc (htab->gc_mark_stack,
+					 size * sizeof (*stack));
+      if (stack == NULL)
+	return FALSE;
+      htab->gc_mark_stack = stack;
+      htab->gc_mark_stack_size = size;
+    }
+  htab->gc_mark_stack[htab->gc_mark_stack_count++] = sec;
+  return TRUE;
+}
+
+/* Mark the sections in the group of the already marked section SEC,
+   and all the sections which define symbols to which it refers.  */
+
+static bfd_boolean
+elf_gc_mark_section_refs (struct bfd_link_info *info,
+			  asection *sec,
+			  elf_gc_mark_hook_fn gc_mark_hook)
+{
+  bfd_boolean ret;
+  asection *group_sec, *eh_frame;
 
   /* Mark all the sections in the group.  */
   group_sec = elf_section_data (sec)->next_in_group;
   if (group_sec && !group_sec->gc_mark)
-    if (!_bfd_elf_gc_mark (info, group_sec, gc_mark_hook))
+    if (!elf_gc_mark_push (info, group_sec))
       return FALSE;
 
   /* Look through the section relocs.  */
@@ -11781,6 +11980,44 @@ _bfd_elf_gc_mark (struct bfd_link_info *info,
   return ret;
 }
 
+/* The mark phase of garbage collection.  For a given section, mark
+   it and any sections in this section's group, and all the sections
+   which define symbols to which it refers.  Rather than recursing
+   through _bfd_elf_gc_mark_reloc, which can run very deep on large
+   links, newly marked sections are pushed on a stack and scanned by
+   the outermost call.  */
+
+bfd_boolean
+_bfd_elf_gc_mark (struct bfd_link_info *info,
+		  asection *sec,
+		  elf_gc_mark_hook_fn gc_mark_hook)
+{
+  struct elf_link_hash_table *htab = elf_hash_table (info);
+  bfd_boolean ret;
+
+  if (!elf_gc_mark_push (info, sec))
+    return FALSE;
+
+  /* An outer call will get to SEC.  */
+  if (htab->gc_mark_active)
+    return TRUE;
+
+  ret = TRUE;
+  htab->gc_mark_active = TRUE;
+  while (htab->gc_mark_stack_count != 0)
+    {
+      sec = htab->gc_mark_stack[--htab->gc_mark_stack_count];
+      if (!elf_gc_mark_section_refs (info, sec, gc_mark_hook))
+	{
+	  ret = FALSE;
+	  break;
+	}
+    }
+  htab->gc_mark_stack_count = 0;
+  htab->gc_mark_active = FALSE;
+  return ret;
+}
+
 /* Keep debug and special sections.  */
 
 bfd_boolean
@@ -12204,7 +12441,7 @@ bfd_elf_gc_sections (bfd *abfd, struct bfd_link_info *info)
 
   /* Grovel through relocs to find out who stays ...  */
   gc_mark_hook = bed->gc_mark_hook;
-  for (sub = info->input_bfds; sub != NULL; sub = sub->link.next)
+  for (sub = info->input_bfds; ok && sub != NULL; sub = sub->link.next)
     {
       asection *o;
 
@@ -12222,12 +12459,22 @@ bfd_elf_gc_sections (bfd *abfd, struct bfd_link_info *info)
 		    && elf_next_in_group (o) == NULL )))
 	  {
 	    if (!_bfd_elf_gc_mark (info, o, gc_mark_hook))
-	      return FALSE;
+	      {
+		ok = FALSE;
+		break;
+	      }
 	  }
     }
 
   /* Allow the backend to mark additional target specific sections.  */
-  bed->gc_mark_extra_sections (info, gc_mark_hook);
+  if (ok)
+    bed->gc_mark_extra_sections (info, gc_mark_hook);
+
+  free (htab->gc_mark_stack);
+  htab->gc_mark_stack = NULL;
+  htab->gc_mark_stack_size = 0;
+  if (!ok)
+    return FALSE;
 
   /* ... and mark SEC_EXCLUDE for those that go.  */
   return elf_gc_sweep (abfd, info);
@@ -46,6 +46,7 @@ SUBSECTION
 #include "sysdep.h"
 #include "bfd.h"
 #include "libbfd.h"
+#include "elf-bfd.h"
 
 /* IMPORT from targets.c.  */
 extern const size_t _bfd_target_vector_entries;
@@ -179,6 +180,68 @@ bfd_preserve_finish (bfd *abfd ATTRIBUTE_UNUSED, struct bfd_preserve *preserve)
   preserve->marker = NULL;
 }
 
+/* The number of bytes at the start of a file that elf_target_may_match
+   looks at: e_ident, e_type and e_machine.  */
+#define ELF_PROBE_SIZE (EI_NIDENT + 4)
+
+/* Return FALSE if the ELF target TARGET would reject an object file
+   starting with the LEN bytes at HEADER on the strength of its ELF
+   header alone.  This mirrors the header checks at the start of
+   elf_object_p, and lets bfd_check_format_matches skip the full probe
+   for the many ELF targets in a multi-target BFD that cannot match.  */
+
+static bfd_boolean
+elf_target_may_match (const bfd_target *target, const bfd_byte *header,
+		      size_t len)
+{
+  const struct elf_backend_data *bed;
+  int machine;
+
+  if (len < ELF_PROBE_SIZE)
+    return TRUE;
+
+  if (header[EI_MAG0] != ELFMAG0
+      || header[EI_MAG1] != ELFMAG1
+      || header[EI_MAG2] != ELFMAG2
+      || header[EI_MAG3] != ELFMAG3
+      || header[EI_VERSION] != EV_CURRENT)
+    return FALSE;
+
+  bed = (const struct elf_backend_data *) target->backend_data;
+  if (header[EI_CLASS] != bed->s->elfclass)
+    return FALSE;
+
+  switch (header[EI_DATA])
+    {
+    case ELFDATA2MSB:
+      if (target->header_byteorder != BFD_ENDIAN_BIG)
+	return FALSE;
+      machine = bfd_getb16 (header + EI_NIDENT + 2);
+      break;
+    case ELFDATA2LSB:
+      if (target->header_byteorder != BFD_ENDIAN_LITTLE)
+	return FALSE;
+      machine = bfd_getl16 (header + EI_NIDENT + 2);
+      break;
+    default:
+      return FALSE;
+    }
+
+  /* The generic targets accept any machine and OS/ABI.  */
+  if (bed->elf_machine_code == EM_NONE)
+    return TRUE;
+
+  if (bed->elf_machine_code != machine
+      && (bed->elf_machine_alt1 == 0 || machine != bed->elf_machine_alt1)
+      && (bed->elf_machine_alt2 == 0 || machine != bed->elf_machine_alt2))
+    return FALSE;
+
+  if (header[EI_OSABI] != bed->elf_osabi && bed->elf_osabi != ELFOSABI_NONE)
+    return FALSE;
+
+  return TRUE;
+}
+
 /*
 FUNCTION
 	bfd_check_format_matches
@@ -209,6 +272,8 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
   int match_count, best_count, best_match;
   int ar_match_index;
   struct bfd_preserve preserve;
+  bfd_byte header[ELF_PROBE_SIZE];
+  size_t header_len;
 
   if (matching != NULL)
     *matching = NULL;
@@ -275,6 +340,18 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
   match_count = 0;
   ar_match_index = _bfd_target_vector_entries;
 
+  /* Read the start of the file once, so that ELF targets which cannot
+     match an object file can be skipped without probing them.  */
+  header_len = 0;
+  if (format == bfd_object)
+    {
+      if (bfd_seek (abfd, (file_ptr) 0, SEEK_SET) != 0)
+	goto err_ret;
+      header_len = bfd_bread (header, sizeof (header), abfd);
+      if (header_len > sizeof (header))
+	header_len = 0;
+    }
+
   for (target = bfd_target_vector; *target != NULL; target++)
     {
       const bfd_target *temp;
@@ -285,6 +362,11 @@ bfd_check_format_matches (bfd *abfd, bfd_format format, char ***matching)
 	  || (*target)->match_priority > best_match)
 	continue;
 
+      if (header_len != 0
+	  && (*target)->flavour == bfd_target_elf_flavour
+	  && !elf_target_may_match (*target, header, header_len))
+	continue;
+
       /* If we already tried a match, the bfd is modified and may
 	 have sections attached, which will confuse the next
 	 _bfd_check_format call.  */
@@ -559,6 +559,14 @@ extern bfd_boolean _bfd_dwarf2_slurp_debug_info
   (bfd *, bfd *, const struct dwarf_debug_section *, asymbol **, void **,
    bfd_boolean);
 
+/* Read all DWARF 2 debugging information for concurrent lookups.  */
+extern bfd_boolean _bfd_dwarf2_prepare_concurrent_lookups
+  (bfd *, asymbol **, const struct dwarf_debug_section *, void **);
+
+/* Find the nearest lines of several addresses, from several threads.  */
+extern bfd_boolean _bfd_dwarf2_find_nearest_lines
+  (void *, struct bfd_line_lookup *, bfd_size_type);
+
 /* Clean up the data used to handle DWARF 2 debugging information. */
 extern void _bfd_dwarf2_cleanup_debug_info
   (bfd *, void **);
@@ -605,6 +613,15 @@ extern bfd_boolean _bfd_generic_link_add_archive_symbols
 		    struct bfd_link_hash_entry *, const char *,
 		    bfd_boolean *));
 
+/* Map symbol names to the archive map entries that may resolve them.  */
+extern bfd_boolean _bfd_link_armap_index_init
+  (struct bfd_hash_table *, bfd *);
+extern bfd_boolean _bfd_link_armap_index_add
+  (struct bfd_hash_table *, const char *, bfd_boolean, symindex);
+extern symindex _bfd_link_armap_index_mark
+  (struct bfd_hash_table *, struct bfd_link_info *,
+   struct bfd_link_hash_entry *, unsigned char *);
+
 /* Forward declaration to avoid prototype errors.  */
 typedef struct bfd_link_hash_entry _bfd_link_hash_entry;
 
@@ -893,6 +910,8 @@ bfd_boolean bfd_cache_init (bfd *abfd);
 
 bfd_boolean bfd_cache_close (bfd *abfd);
 
+bfd_boolean bfd_cache_shrink (void);
+
 FILE* bfd_open_file (bfd *abfd);
 
 /* Extracted from reloc.c.  */
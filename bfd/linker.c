@@ -908,6 +908,133 @@ generic_link_add_object_symbols (bfd *abfd,
   return generic_link_add_symbol_list (abfd, info, symcount, outsyms, collect);
 }
 
+/* An archive map index maps a symbol name to the archive map
+   entries which may resolve an undefined reference to that name.
+   It lets the archive add symbol routines rescan only those entries
+   that can be affected by the undefined symbols added since the last
+   scan, rather than the whole archive map.  */
+
+struct armap_index_ref
+{
+  struct armap_index_ref *next;
+  symindex indx;
+};
+
+struct armap_index_entry
+{
+  struct bfd_hash_entry root;
+  struct armap_index_ref *refs;
+};
+
+static struct bfd_hash_entry *
+armap_index_newfunc (struct bfd_hash_entry *entry,
+		     struct bfd_hash_table *table,
+		     const char *string)
+{
+  if (entry == NULL)
+    {
+      entry = (struct bfd_hash_entry *)
+	bfd_hash_allocate (table, sizeof (struct armap_index_entry));
+      if (entry == NULL)
+	return NULL;
+    }
+
+  entry = bfd_hash_newfunc (entry, table, string);
+  if (entry != NULL)
+    ((struct armap_index_entry *) entry)->refs = NULL;
+  return entry;
+}
+
+/* Record that archive map entry INDX may resolve NAME.  COPY is TRUE
+   if NAME does not live as long as TABLE.  */
+
+bfd_boolean
+_bfd_link_armap_index_add (struct bfd_hash_table *table,
+			   const char *name,
+			   bfd_boolean copy,
+			   symindex indx)
+{
+  struct armap_index_entry *entry;
+  struct armap_index_ref *ref;
+
+  entry = (struct armap_index_entry *) bfd_hash_lookup (table, name,
+							 TRUE, copy);
+  if (entry == NULL)
+    return FALSE;
+
+  /* Entries for the same name are added in increasing order.  */
+  if (entry->refs != NULL && entry->refs->indx == indx)
+    return TRUE;
+
+  ref = (struct armap_index_ref *) bfd_hash_allocate (table, sizeof (*ref));
+  if (ref == NULL)
+    return FALSE;
+  ref->indx = indx;
+  ref->next = entry->refs;
+  entry->refs = ref;
+  return TRUE;
+}
+
+/* Create an archive map index for the archive ABFD, holding the
+   names in its archive map.  */
+
+bfd_boolean
+_bfd_link_armap_index_init (struct bfd_hash_table *table, bfd *abfd)
+{
+  carsym *arsyms;
+  symindex count, indx;
+
+  arsyms = bfd_ardata (abfd)->symdefs;
+  count = bfd_ardata (abfd)->symdef_count;
+  if (!bfd_hash_table_init (table, armap_index_newfunc,
+			    sizeof (struct armap_index_entry)))
+    return FALSE;
+
+  for (indx = 0; indx < count; indx++)
+    if (!_bfd_link_armap_index_add (table, arsyms[indx].name, FALSE, indx))
+      {
+	bfd_hash_table_free (table);
+	return FALSE;
+      }
+  return TRUE;
+}
+
+/* Set PENDING for each archive map entry in TABLE that names a symbol
+   added to the undefs list of INFO after UNDEFS_TAIL, or added at
+   all if UNDEFS_TAIL is NULL.  Return the lowest entry set, or
+   BFD_NO_MORE_SYMBOLS if none.  */
+
+symindex
+_bfd_link_armap_index_mark (struct bfd_hash_table *table,
+			    struct bfd_link_info *info,
+			    struct bfd_link_hash_entry *undefs_tail,
+			    unsigned char *pending)
+{
+  struct bfd_link_hash_entry *h;
+  symindex lowest;
+
+  lowest = BFD_NO_MORE_SYMBOLS;
+  h = undefs_tail != NULL ? undefs_tail->u.undef.next : info->hash->undefs;
+  for (; h != NULL; h = h->u.undef.next)
+    {
+      struct armap_index_entry *entry;
+      struct armap_index_ref *ref;
+
+      entry = (struct armap_index_entry *) bfd_hash_lookup (table,
+							     h->root.string,
+							     FALSE, FALSE);
+      if (entry == NULL)
+	continue;
+      for (ref = entry->refs; ref != NULL; ref = ref->next)
+	{
+	  pending[ref->indx] = 1;
+	  if (lowest == BFD_NO_MORE_SYMBOLS || ref->indx < lowest)
+	    lowest = ref->indx;
+	}
+    }
+  return lowest;
+}
+
 /* Generic function to add symbols from an archive file to the global
    hash file.  This function presumes that the archive symbol table
    has already been read in (this is normally done by the
@@ -921,7 +1048,11 @@ generic_link_add_object_symbols (bfd *abfd,
    adding the symbols to the global hash table.  CHECKFN must notice
    if the callback indicates a substitute BFD, and arrange to add
    those symbols instead if it does so.  CHECKFN should only return
-   FALSE if some sort of error occurs.  */
+   FALSE if some sort of error occurs.
+
+   The first pass looks at every archive map entry.  Later passes only
+   look at the entries that name a symbol made undefined since the
+   entry was last looked at, since the others cannot have changed.  */
 
 bfd_boolean
 _bfd_generic_link_add_archive_symbols
@@ -933,7 +1064,11 @@ _bfd_generic_link_add_archive_symbols
 {
   bfd_boolean loop;
   bfd_size_type amt;
+  symindex count;
   unsigned char *included;
+  unsigned char *pending;
+  struct bfd_hash_table armap_index;
+  bfd_boolean indexed;
 
   if (! bfd_has_map (abfd))
     {
@@ -944,39 +1079,50 @@ _bfd_generic_link_add_archive_symbols
       return FALSE;
     }
 
-  amt = bfd_ardata (abfd)->symdef_count;
-  if (amt == 0)
+  count = bfd_ardata (abfd)->symdef_count;
+  if (count == 0)
     return TRUE;
-  amt *= sizeof (*included);
+  amt = count;
+  amt *= 2 * sizeof (*included);
   included = (unsigned char *) bfd_zmalloc (amt);
   if (included == NULL)
     return FALSE;
+  pending = included + count;
+  memset (pending, 1, count);
+  indexed = FALSE;
 
   do
     {
       carsym *arsyms;
-      carsym *arsym_end;
       carsym *arsym;
-      unsigned int indx;
+      symindex indx;
       file_ptr last_ar_offset = -1;
       bfd_boolean needed = FALSE;
+      bfd_boolean retry = FALSE;
       bfd *element = NULL;
+      struct bfd_link_hash_entry *pass_undefs_tail;
 
       loop = FALSE;
+      pass_undefs_tail = info->hash->undefs_tail;
+      info->archive_passes++;
       arsyms = bfd_ardata (abfd)->symdefs;
-      arsym_end = arsyms + bfd_ardata (abfd)->symdef_count;
-      for (arsym = arsyms, indx = 0; arsym < arsym_end; arsym++, indx++)
+      for (indx = 0; indx < count; indx++)
 	{
 	  struct bfd_link_hash_entry *h;
 	  struct bfd_link_hash_entry *undefs_tail;
 
+	  if (!pending[indx])
+	    continue;
+	  pending[indx] = 0;
 	  if (included[indx])
 	    continue;
+	  arsym = arsyms + indx;
 	  if (needed && arsym->file_offset == last_ar_offset)
 	    {
 	      included[indx] = 1;
 	      continue;
 	    }
+	  info->archive_lookups++;
 
 	  h = bfd_link_hash_lookup (info->hash, arsym->name,
 				    FALSE, FALSE, TRUE);
@@ -995,6 +1141,14 @@ _bfd_generic_link_add_archive_symbols
 	      if (h->type != bfd_link_hash_undefweak)
 		/* Symbol must be defined.  Don't check it again.  */
 		included[indx] = 1;
+	      else if (strcmp (h->root.string, arsym->name) != 0)
+		{
+		  /* We followed an indirect or warning symbol, so the
+		     index will not notice if H becomes undefined.
+		     Check this entry again on any later pass.  */
+		  pending[indx] = 1;
+		  retry = TRUE;
+		}
 	      continue;
 	    }
 
@@ -1016,10 +1170,10 @@ _bfd_generic_link_add_archive_symbols
 
 	  if (needed)
 	    {
-	      unsigned int mark;
+	      symindex mark;
 
-	      /* Look backward to mark all symbols from this object file
-		 which we have already seen in this pass.  */
+	      /* Mark all symbols from this object file which are
+		 adjacent to this one.  */
 	      mark = indx;
 	      do
 		{
@@ -1029,17 +1183,56 @@ _bfd_generic_link_add_archive_symbols
 		  --mark;
 		}
 	      while (arsyms[mark].file_offset == last_ar_offset);
+	      for (mark = indx + 1;
+		   mark < count && arsyms[mark].file_offset == last_ar_offset;
+		   mark++)
+		included[mark] = 1;
 
 	      if (undefs_tail != info->hash->undefs_tail)
-		loop = TRUE;
+		{
+		  /* Note the entries that might now be resolved.  Only
+		     those before this one need another pass.  */
+		  if (!indexed)
+		    {
+		      if (!_bfd_link_armap_index_init (&armap_index, abfd))
+			goto error_return;
+		      if (info->pei386_auto_import)
+			{
+			  symindex i;
+
+			  for (i = 0; i < count; i++)
+			    if (CONST_STRNEQ (arsyms[i].name, "__imp_")
+				&& !_bfd_link_armap_index_add (&armap_index,
+							       arsyms[i].name + 6,
+							       FALSE, i))
+			      {
+				bfd_hash_table_free (&armap_index);
+				goto error_return;
+			      }
+			}
+		      indexed = TRUE;
+		    }
+		  if (_bfd_link_armap_index_mark (&armap_index, info,
+						  undefs_tail, pending) <= indx)
+		    loop = TRUE;
+		}
 	    }
 	}
+
+      /* Entries that followed an indirect symbol only need another
+	 look if some symbol became undefined.  */
+      if (retry && pass_undefs_tail != info->hash->undefs_tail)
+	loop = TRUE;
     } while (loop);
 
+  if (indexed)
+    bfd_hash_table_free (&armap_index);
   free (included);
   return TRUE;
 
  error_return:
+  if (indexed)
+    bfd_hash_table_free (&armap_index);
   free (included);
   return FALSE;
 }
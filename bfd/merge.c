@@ -527,18 +527,49 @@ error_return:
   return FALSE;
 }
 
+/* The number of characters packed into a sort key by rev_key_at, each
+   in 9 bits so that the end of a string can sort before any character.  */
+#define REV_KEY_CHARS ((sizeof (unsigned long) * 8) / 9)
+
+/* Return a key for the REV_KEY_CHARS characters that are DEPTH
+   characters and more from the end of E's string, read backwards.  A
+   string ending earlier sorts first, as in strrevcmp, so comparing the
+   keys of two strings compares that many characters of them at once.
+   The low 9 bits of the key are zero if E's string ends within them.  */
+
+static inline unsigned long
+rev_key_at (const struct sec_merge_hash_entry *e, unsigned int depth)
+{
+  const unsigned char *s = (const unsigned char *) e->root.string;
+  unsigned long key = 0;
+  unsigned int i;
+
+  for (i = 0; i < REV_KEY_CHARS; i++)
+    {
+      key <<= 9;
+      if (depth + i < e->len)
+	key |= s[e->len - 1 - depth - i] + 1;
+    }
+  return key;
+}
+
+/* Compare the strings of A and B backwards, given that their last
+   DEPTH characters are the same.  */
+
 static int
-strrevcmp (const void *a, const void *b)
+strrevcmp (const struct sec_merge_hash_entry *A,
+	   const struct sec_merge_hash_entry *B,
+	   unsigned int depth)
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
   unsigned int lenA = A->len;
   unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
+  const unsigned char *s;
+  const unsigned char *t;
+  int l = (lenA < lenB ? lenA : lenB) - depth;
 
-  while (l)
+  s = (const unsigned char *) A->root.string + lenA - 1 - depth;
+  t = (const unsigned char *) B->root.string + lenB - 1 - depth;
+  while (l > 0)
     {
       if (*s != *t)
 	return (int) *s - (int) *t;
@@ -549,33 +580,133 @@ strrevcmp (const void *a, const void *b)
   return lenA - lenB;
 }
 
-/* Like strrevcmp, but for the case where all strings have the same
-   alignment > entsize.  */
+/* A string to sort in merge_strings, with the key of its characters
+   at the depth being sorted on.  */
 
-static int
-strrevcmp_align (const void *a, const void *b)
+struct rev_sort_entry
 {
-  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
-  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
-  unsigned int lenA = A->len;
-  unsigned int lenB = B->len;
-  const unsigned char *s = (const unsigned char *) A->root.string + lenA - 1;
-  const unsigned char *t = (const unsigned char *) B->root.string + lenB - 1;
-  int l = lenA < lenB ? lenA : lenB;
-  int tail_align = (lenA & (A->alignment - 1)) - (lenB & (A->alignment - 1));
+  unsigned long key;
+  struct sec_merge_hash_entry *entry;
+};
 
-  if (tail_align != 0)
-    return tail_align;
+/* Sort the N entries in ARRAY by their strings read backwards, as
+   strrevcmp orders them, given that their last DEPTH characters are
+   the same and that their keys are those at DEPTH.  This is a multikey
+   quicksort: each pass partitions on the key of the next few
+   characters, so a long suffix shared by many strings is read once
+   per string instead of once per comparison, as qsort would.  The
+   strings are all different, so the result is the same as a
+   comparison sort gives.  */
 
-  while (l)
+static void
+sort_strings_reversed (struct rev_sort_entry *array, size_t n,
+		       unsigned int depth)
+{
+  while (n > 1)
     {
-      if (*s != *t)
-	return (int) *s - (int) *t;
-      s--;
-      t--;
-      l--;
+      struct rev_sort_entry tmp;
+      size_t lt, gt, i;
+      unsigned long pivot, k0, k1, k2;
+      bfd_boolean more;
+
+      if (n < 8)
+	{
+	  for (i = 1; i < n; i++)
+	    for (lt = i;
+		 lt > 0 && strrevcmp (array[lt - 1].entry, array[lt].entry,
+				      depth) > 0;
+		 lt--)
+	      {
+		tmp = array[lt];
+		array[lt] = array[lt - 1];
+		array[lt - 1] = tmp;
+	      }
+	  return;
+	}
+
+      /* Take the median of three as the pivot.  */
+      k0 = array[0].key;
+      k1 = array[n / 2].key;
+      k2 = array[n - 1].key;
+      if (k0 > k1)
+	{
+	  pivot = k0;
+	  k0 = k1;
+	  k1 = pivot;
+	}
+      pivot = k2 < k0 ? k0 : k2 > k1 ? k1 : k2;
+
+      /* Partition into [0, lt) below, [lt, gt) equal to and [gt, n)
+	 above the pivot.  */
+      lt = 0;
+      gt = n;
+      i = 0;
+      while (i < gt)
+	{
+	  if (array[i].key < pivot)
+	    {
+	      tmp = array[lt];
+	      array[lt++] = array[i];
+	      array[i++] = tmp;
+	    }
+	  else if (array[i].key > pivot)
+	    {
+	      tmp = array[--gt];
+	      array[gt] = array[i];
+	      array[i] = tmp;
+	    }
+	  else
+	    i++;
+	}
+
+      /* Strings equal up to their end are the same string, so only one
+	 can end within the pivot.  The others go on to the next key.  */
+      more = (pivot & 0x1ff) != 0;
+      if (more)
+	for (i = lt; i < gt; i++)
+	  array[i].key = rev_key_at (array[i].entry, depth + REV_KEY_CHARS);
+
+      /* Recurse on the two smaller parts and loop on the largest, to
+	 bound the depth of recursion.  */
+      if (more && gt - lt >= lt && gt - lt >= n - gt)
+	{
+	  sort_strings_reversed (array, lt, depth);
+	  sort_strings_reversed (array + gt, n - gt, depth);
+	  array += lt;
+	  n = gt - lt;
+	  depth += REV_KEY_CHARS;
+	}
+      else
+	{
+	  if (more)
+	    sort_strings_reversed (array + lt, gt - lt,
+				   depth + REV_KEY_CHARS);
+	  if (lt >= n - gt)
+	    {
+	      sort_strings_reversed (array + gt, n - gt, depth);
+	      n = lt;
+	    }
+	  else
+	    {
+	      sort_strings_reversed (array, lt, depth);
+	      array += gt;
+	      n -= gt;
+	    }
+	}
     }
-  return lenA - lenB;
+}
+
+/* Compare function for sorting by the length of the string modulo
+   its alignment, used when all strings have the same alignment
+   > entsize.  */
+
+static int
+tail_align_cmp (const void *a, const void *b)
+{
+  struct sec_merge_hash_entry *A = *(struct sec_merge_hash_entry **) a;
+  struct sec_merge_hash_entry *B = *(struct sec_merge_hash_entry **) b;
+
+  return (int) (A->len & (A->alignment - 1)) - (B->len & (A->alignment - 1));
 }
 
 static inline int
@@ -597,8 +728,9 @@ static void
 merge_strings (struct sec_merge_info *sinfo)
 {
   struct sec_merge_hash_entry **array, **a, *e;
+  struct rev_sort_entry *sorted = NULL;
   struct sec_merge_sec_info *secinfo;
-  bfd_size_type size, amt;
+  bfd_size_type size, amt, i, j;
   unsigned int alignment = 0;
 
   /* Now sort the strings */
@@ -606,6 +738,10 @@ merge_strings (struct sec_merge_info *sinfo)
   array = (struct sec_merge_hash_entry **) bfd_malloc (amt);
   if (array == NULL)
     goto alloc_failure;
+  amt = sinfo->htab->size * sizeof (struct rev_sort_entry);
+  sorted = (struct rev_sort_entry *) bfd_malloc (amt);
+  if (sorted == NULL)
+    goto alloc_failure;
 
   for (e = sinfo->htab->first, a = array; e; e = e->next)
     if (e->alignment)
@@ -625,10 +761,29 @@ merge_strings (struct sec_merge_info *sinfo)
   sinfo->htab->size = a - array;
   if (sinfo->htab->size != 0)
     {
-      qsort (array, (size_t) sinfo->htab->size,
-	     sizeof (struct sec_merge_hash_entry *),
-	     (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize
-	      ? strrevcmp_align : strrevcmp));
+      /* A string can only be a suffix of another whose length is the
+	 same modulo the alignment, so when all have the same alignment
+	 > entsize, group them by that first.  */
+      if (alignment != (unsigned) -1 && alignment > sinfo->htab->entsize)
+	qsort (array, (size_t) sinfo->htab->size,
+	       sizeof (struct sec_merge_hash_entry *), tail_align_cmp);
+      else
+	alignment = 0;
+
+      for (i = 0; i < sinfo->htab->size; i++)
+	{
+	  sorted[i].entry = array[i];
+	  sorted[i].key = rev_key_at (array[i], 0);
+	}
+      for (i = 0; i < sinfo->htab->size; i = j)
+	{
+	  for (j = i + 1; j < sinfo->htab->size; j++)
+	    if (alignment != 0 && tail_align_cmp (&array[i], &array[j]) != 0)
+	      break;
+	  sort_strings_reversed (sorted + i, j - i, 0);
+	}
+      for (i = 0; i < sinfo->htab->size; i++)
+	array[i] = sorted[i].entry;
 
       /* Loop over the sorted array and merge suffixes */
       e = *--a;
@@ -653,6 +808,8 @@ merge_strings (struct sec_merge_info *sinfo)
 alloc_failure:
   if (array)
     free (array);
+  if (sorted)
+    free (sorted);
 
   /* Now assign positions to the strings we want to keep.  */
   size = 0;
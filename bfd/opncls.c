@@ -216,7 +216,11 @@ bfd_fopen (const char *filename, const char *target, const char *mode, int fd)
     nbfd->iostream = fdopen (fd, mode);
   else
 #endif
-    nbfd->iostream = real_fopen (filename, mode);
+    {
+      nbfd->iostream = real_fopen (filename, mode);
+      if (nbfd->iostream == NULL && bfd_cache_shrink ())
+	nbfd->iostream = real_fopen (filename, mode);
+    }
   if (nbfd->iostream == NULL)
     {
       bfd_set_error (bfd_error_system_call);
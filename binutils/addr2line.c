@@ -70,6 +70,8 @@ static void usage (FILE *, int);
 static void slurp_symtab (bfd *);
 static void find_address_in_section (bfd *, asection *, void *);
 static void find_offset_in_section (bfd *, asection *);
+static bfd_vma scan_address (bfd *, const char *);
+static struct bfd_line_lookup *find_lines_in_elf_file (bfd *, asection *);
 static void translate_addresses (bfd *, asection *);
 
 /* Print a usage message to STREAM and exit with STATUS.  */
@@ -152,6 +154,11 @@ static unsigned int line;
 static unsigned int discriminator;
 static bfd_boolean found;
 
+/* If not NULL, the result of looking up PC with
+   bfd_elf_find_nearest_lines.  */
+
+static struct bfd_line_lookup *lookup;
+
 /* Look for an address in a section.  This is called via
    bfd_map_over_sections.  */
 
@@ -176,6 +183,18 @@ find_address_in_section (bfd *abfd, asection *section,
   if (pc >= vma + size)
     return;
 
+  /* bfd_elf_find_nearest_lines does not look in the symbol table for
+     a function name, so only use its result if it found one.  */
+  if (lookup != NULL && lookup->functionname != NULL)
+    {
+      filename = lookup->filename;
+      functionname = lookup->functionname;
+      line = lookup->line;
+      discriminator = lookup->discriminator;
+      found = TRUE;
+      return;
+    }
+
   found = bfd_find_nearest_line_discriminator (abfd, section, syms, pc - vma,
                                                &filename, &functionname,
                                                &line, &discriminator);
@@ -203,6 +222,60 @@ find_offset_in_section (bfd *abfd, asection *section)
                                                &line, &discriminator);
 }
 
+/* Convert the hexadecimal address ADDR_HEX to an address in ABFD.  */
+
+static bfd_vma
+scan_address (bfd *abfd, const char *addr_hex)
+{
+  bfd_vma vma = bfd_scan_vma (addr_hex, NULL, 16);
+
+  if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
+    {
+      const struct elf_backend_data *bed = get_elf_backend_data (abfd);
+      bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
+
+      vma &= (sign << 1) - 1;
+      if (bed->sign_extend_vma)
+	vma = (vma ^ sign) - sign;
+    }
+
+  return vma;
+}
+
+/* Look up all NADDR addresses given on the command line at once, if
+   ABFD is an ELF executable or shared library.  This reads all of the
+   DWARF info once up front, rather than searching it anew for each
+   address.  Return an array of the results, or NULL.  */
+
+static struct bfd_line_lookup *
+find_lines_in_elf_file (bfd *abfd, asection *section)
+{
+  struct bfd_line_lookup *lookups;
+  int i;
+
+  /* bfd_elf_find_nearest_lines keeps no inliner info, and takes
+     VMAs rather than section offsets.  */
+  if (naddr < 2
+      || unwind_inlines
+      || section != NULL
+      || bfd_get_flavour (abfd) != bfd_target_elf_flavour
+      || (abfd->flags & (EXEC_P | DYNAMIC)) == 0
+      || ! bfd_elf_prepare_line_lookups (abfd, syms))
+    return NULL;
+
+  lookups = (struct bfd_line_lookup *) xmalloc (naddr * sizeof (*lookups));
+  for (i = 0; i < naddr; i++)
+    lookups[i].address = scan_address (abfd, addr[i]);
+
+  if (! bfd_elf_find_nearest_lines (abfd, lookups, naddr))
+    {
+      free (lookups);
+      return NULL;
+    }
+
+  return lookups;
+}
+
 /* Read hexadecimal addresses from stdin, translate into
    file_name:line_number and optionally function name.  */
 
@@ -210,6 +283,14 @@ static void
 translate_addresses (bfd *abfd, asection *section)
 {
   int read_stdin = (naddr == 0);
+  struct bfd_line_lookup *lookups = NULL;
+  struct bfd_line_lookup *next_lookup = NULL;
+
+  if (! read_stdin)
+    {
+      lookups = find_lines_in_elf_file (abfd, section);
+      next_lookup = lookups;
+    }
 
   for (;;)
     {
@@ -219,24 +300,16 @@ translate_addresses (bfd *abfd, asection *section)
 
 	  if (fgets (addr_hex, sizeof addr_hex, stdin) == NULL)
 	    break;
-	  pc = bfd_scan_vma (addr_hex, NULL, 16);
+	  pc = scan_address (abfd, addr_hex);
 	}
       else
 	{
 	  if (naddr <= 0)
 	    break;
 	  --naddr;
-	  pc = bfd_scan_vma (*addr++, NULL, 16);
-	}
-
-      if (bfd_get_flavour (abfd) == bfd_target_elf_flavour)
-	{
-	  const struct elf_backend_data *bed = get_elf_backend_data (abfd);
-	  bfd_vma sign = (bfd_vma) 1 << (bed->s->arch_size - 1);
-
-	  pc &= (sign << 1) - 1;
-	  if (bed->sign_extend_vma)
-	    pc = (pc ^ sign) - sign;
+	  pc = scan_address (abfd, *addr++);
+	  if (next_lookup != NULL)
+	    lookup = next_lookup++;
 	}
 
       if (with_addresses)
@@ -344,6 +417,10 @@ translate_addresses (bfd *abfd, asection *section)
          time.  */
       fflush (stdout);
     }
+
+  lookup = NULL;
+  if (lookups != NULL)
+    free (lookups);
 }
 
 /* Process a file.  Returns an exit value for main().  */
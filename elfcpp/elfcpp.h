@@ -1480,6 +1480,43 @@ class Sym_write
   internal::Sym_data<size>* p_;
 };
 
+// Sym_block converts an array of symbol table entries from target to
+// host order in one call, as Swap_block does for words.  Code which
+// reads most fields of many symbols can convert them into a host-order
+// buffer once, and then view each entry with
+// Sym<size, Endian::host_big_endian>, whose accessors do no swapping.
+
+template<int size, bool big_endian>
+struct Sym_block
+{
+  // Convert COUNT symbols at FROM into host order at TO, which must
+  // have room for COUNT symbols.
+  static inline void
+  readvals(const unsigned char* from, unsigned char* to, size_t count)
+  {
+    if (big_endian == Endian::host_big_endian)
+      memcpy(to, from, count * sizeof(internal::Sym_data<size>));
+    else
+      {
+	const internal::Sym_data<size>* f =
+	  reinterpret_cast<const internal::Sym_data<size>*>(from);
+	internal::Sym_data<size>* t =
+	  reinterpret_cast<internal::Sym_data<size>*>(to);
+	for (size_t i = 0; i < count; ++i)
+	  {
+	    t[i].st_name = Convert<32, big_endian>::convert_host(f[i].st_name);
+	    t[i].st_value =
+	      Convert<size, big_endian>::convert_host(f[i].st_value);
+	    t[i].st_size = Convert<size, big_endian>::convert_host(f[i].st_size);
+	    t[i].st_info = f[i].st_info;
+	    t[i].st_other = f[i].st_other;
+	    t[i].st_shndx =
+	      Convert<16, big_endian>::convert_host(f[i].st_shndx);
+	  }
+      }
+  }
+};
+
 // Accessor classes for an ELF REL relocation entry.
 
 template<int size, bool big_endian>
@@ -44,6 +44,8 @@
 
 #include "config.h"
 
+#include <cstring>
+
 #ifdef HAVE_BYTESWAP_H
 #include <byteswap.h>
 #else
@@ -86,6 +88,13 @@ bswap_64(uint64_t v)
 #define bswap_64 __builtin_bswap64
 #endif
 
+// gcc 4.8 and later also provides __builtin_bswap16.
+
+#if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#undef bswap_16
+#define bswap_16 __builtin_bswap16
+#endif
+
 namespace elfcpp
 {
 
@@ -263,6 +272,50 @@ struct Swap<8, big_endian>
   { *wv = v; }
 };
 
+// Swap_block is a template based on size and on whether the target
+// is big endian.  It defines the functions readvals and writevals,
+// which convert an array of COUNT aligned values between target and
+// host order in one call.  Code which needs every element of a
+// target-order array, such as an SHT_GROUP or SHT_SYMTAB_SHNDX
+// section, can convert the whole array into a host-order buffer and
+// then index it directly.  When the host and target have the same
+// endianness this is a memcpy; otherwise it is a simple loop, which
+// the compiler can turn into vector byte shuffles.
+
+template<int size, bool big_endian>
+struct Swap_block
+{
+  typedef typename Valtype_base<size>::Valtype Valtype;
+
+  // Convert COUNT target-order values at FROM into host order at TO.
+  static inline void
+  readvals(const unsigned char* from, Valtype* to, size_t count)
+  {
+    if (big_endian == Endian::host_big_endian)
+      memcpy(to, from, count * sizeof(Valtype));
+    else
+      {
+	const Valtype* f = reinterpret_cast<const Valtype*>(from);
+	for (size_t i = 0; i < count; ++i)
+	  to[i] = Convert<size, big_endian>::convert_host(f[i]);
+      }
+  }
+
+  // Convert COUNT host-order values at FROM into target order at TO.
+  static inline void
+  writevals(unsigned char* to, const Valtype* from, size_t count)
+  {
+    if (big_endian == Endian::host_big_endian)
+      memcpy(to, from, count * sizeof(Valtype));
+    else
+      {
+	Valtype* t = reinterpret_cast<Valtype*>(to);
+	for (size_t i = 0; i < count; ++i)
+	  t[i] = Convert<size, big_endian>::convert_host(from[i]);
+      }
+  }
+};
+
 // Swap_unaligned is a template based on size and on whether the
 // target is big endian.  It defines the type Valtype and the
 // functions readval and writeval.  The functions read and write
@@ -25,6 +25,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -87,18 +88,48 @@ class Cref_inputs
   // that archive.
   typedef std::map<std::string, Archive_info> Archives;
 
-  // For --cref, we build a cross reference table which maps from
-  // symbols to lists of objects.  The symbols are sorted
-  // alphabetically.
+  // For --cref, we gather one entry for each reference to a global
+  // symbol by an object.  Sorting these by symbol address groups the
+  // references to each symbol together cheaply; only the distinct
+  // symbols are then sorted alphabetically.
 
-  class Cref_table_compare
+  struct Cref_entry
+  {
+    // The symbol.
+    const Symbol* sym;
+    // Where to list the object among the objects which refer to SYM:
+    // 0 for the object which defines SYM, otherwise one more than the
+    // position of the object in the list of inputs.
+    size_t order;
+    // The object.
+    Object* object;
+  };
+
+  typedef std::vector<Cref_entry> Cref_table;
+
+  // Sort Cref_entry objects by symbol address and then by order.
+  class Cref_entry_compare
   {
   public:
     bool
-    operator()(const Symbol*, const Symbol*) const;
+    operator()(const Cref_entry& e1, const Cref_entry& e2) const
+    {
+      if (e1.sym != e2.sym)
+	return e1.sym < e2.sym;
+      return e1.order < e2.order;
+    }
   };
 
-  typedef std::map<const Symbol*, Objects*, Cref_table_compare> Cref_table;
+  // Sort the symbols alphabetically.  Each element is a symbol and
+  // the index of its first entry in the sorted Cref_table.
+  typedef std::pair<const Symbol*, size_t> Cref_symbol;
+
+  class Cref_symbol_compare
+  {
+  public:
+    bool
+    operator()(const Cref_symbol&, const Cref_symbol&) const;
+  };
 
   // Report symbol counts for a list of Objects.
   void
@@ -110,7 +141,7 @@ class Cref_inputs
 
   // Gather cross reference information.
   void
-  gather_cref(const Objects*, Cref_table*) const;
+  gather_cref(const Objects*, size_t*, Cref_table*) const;
 
   // List of input objects.
   Objects objects_;
@@ -214,9 +245,11 @@ Cref_inputs::print_symbol_counts(const Symbol_table* symtab, FILE* f) const
 // Sort symbols for the cross reference table.
 
 bool
-Cref_inputs::Cref_table_compare::operator()(const Symbol* s1,
-					    const Symbol* s2) const
+Cref_inputs::Cref_symbol_compare::operator()(const Cref_symbol& c1,
+					     const Cref_symbol& c2) const
 {
+  const Symbol* s1 = c1.first;
+  const Symbol* s2 = c2.first;
   int i = strcmp(s1->name(), s2->name());
   if (i != 0)
     return i < 0;
@@ -242,15 +275,18 @@ Cref_inputs::Cref_table_compare::operator()(const Symbol* s1,
   gold_unreachable();
 }
 
-// Gather cross reference information from a list of inputs.
+// Gather cross reference information from a list of inputs.  *PSEQ
+// is the position of the next object in the list of all inputs.
 
 void
-Cref_inputs::gather_cref(const Objects* objects, Cref_table* table) const
+Cref_inputs::gather_cref(const Objects* objects, size_t* pseq,
+			 Cref_table* table) const
 {
   for (Objects::const_iterator po = objects->begin();
        po != objects->end();
        ++po)
     {
+      ++*pseq;
       const Object::Symbols* symbols = (*po)->get_global_symbols();
       if (symbols == NULL)
 	continue;
@@ -261,18 +297,16 @@ Cref_inputs::gather_cref(const Objects* objects, Cref_table* table) const
 	  const Symbol* sym = *ps;
 	  if (sym == NULL)
 	    continue;
-	  Objects* const onull = NULL;
-	  std::pair<Cref_table::iterator, bool> ins =
-	    table->insert(std::make_pair(sym, onull));
-	  Cref_table::iterator pc = ins.first;
-	  if (ins.second)
-	    pc->second = new Objects();
+	  Cref_entry entry;
+	  entry.sym = sym;
 	  if (sym->source() == Symbol::FROM_OBJECT
 	      && sym->object() == *po
 	      && sym->is_defined())
-	    pc->second->insert(pc->second->begin(), *po);
+	    entry.order = 0;
 	  else
-	    pc->second->push_back(*po);
+	    entry.order = *pseq;
+	  entry.object = *po;
+	  table->push_back(entry);
 	}
     }
 }
@@ -287,24 +321,38 @@ void
 Cref_inputs::print_cref(const Symbol_table*, FILE* f) const
 {
   Cref_table table;
-  this->gather_cref(&this->objects_, &table);
+  size_t seq = 0;
+  this->gather_cref(&this->objects_, &seq, &table);
   for (Archives::const_iterator p = this->archives_.begin();
        p != this->archives_.end();
        ++p)
-    this->gather_cref(p->second.objects, &table);
+    this->gather_cref(p->second.objects, &seq, &table);
+
+  std::sort(table.begin(), table.end(), Cref_entry_compare());
 
-  for (Cref_table::const_iterator pc = table.begin();
-       pc != table.end();
+  std::vector<Cref_symbol> symbols;
+  for (size_t i = 0; i < table.size(); ++i)
+    if (i == 0 || table[i].sym != table[i - 1].sym)
+      symbols.push_back(std::make_pair(table[i].sym, i));
+  std::sort(symbols.begin(), symbols.end(), Cref_symbol_compare());
+
+  for (std::vector<Cref_symbol>::const_iterator pc = symbols.begin();
+       pc != symbols.end();
        ++pc)
     {
-      // If all the objects are dynamic, skip this symbol.
+      // The entries for this symbol are at TABLE[BEGIN, END).
       const Symbol* sym = pc->first;
-      const Objects* objects = pc->second;
-      Objects::const_iterator po;
-      for (po = objects->begin(); po != objects->end(); ++po)
-	if (!(*po)->is_dynamic())
+      const size_t begin = pc->second;
+      size_t end = begin;
+      while (end < table.size() && table[end].sym == sym)
+	++end;
+
+      // If all the objects are dynamic, skip this symbol.
+      size_t i;
+      for (i = begin; i < end; ++i)
+	if (!table[i].object->is_dynamic())
 	  break;
-      if (po == objects->end())
+      if (i == end)
 	continue;
 
       std::string s = sym->demangled_name();
@@ -320,10 +368,10 @@ Cref_inputs::print_cref(const Symbol_table*, FILE* f) const
 
       size_t len = s.length();
 
-      for (po = objects->begin(); po != objects->end(); ++po)
+      for (i = begin; i < end; ++i)
 	{
 	  int n = len < filecol ? filecol - len : 1;
-	  fprintf(f, "%*c%s\n", n, ' ', (*po)->name().c_str());
+	  fprintf(f, "%*c%s\n", n, ' ', table[i].object->name().c_str());
 	  len = 0;
 	}
     }
@@ -28,6 +28,10 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+#ifdef HAVE_SETRLIMIT
+#include <sys/resource.h>
+#endif
+
 #include "parameters.h"
 #include "options.h"
 #include "gold-threads.h"
@@ -59,15 +63,52 @@ namespace gold
 // Class Descriptors.
 
 // The default for limit_ is meant to simply be large.  It gets
-// adjusted downward if we run out of file descriptors.
+// adjusted downward by set_limit_from_rlimit, or if we run out of
+// file descriptors.
 
 Descriptors::Descriptors()
-  : lock_(NULL), initialize_lock_(&this->lock_), open_descriptors_(),
-    stack_top_(-1), current_(0), limit_(8192 - 16)
+  : lock_(NULL), initialize_lock_(&this->lock_, "descriptors"),
+    open_descriptors_(), stack_top_(-1), current_(0), limit_(8192 - 16),
+    open_count_(0), reuse_count_(0), close_count_(0)
 {
   this->open_descriptors_.reserve(128);
 }
 
+// Keeping a descriptor open is much cheaper than closing the file
+// and opening it again when it is next needed, particularly on a
+// network file system.  The soft limit on open files is often far
+// below the hard limit, so raise it as far as our own default limit,
+// and set limit_ from the result.  That way we rarely have to close
+// descriptors, and we never learn the limit by having open fail.
+
+void
+Descriptors::set_limit_from_rlimit()
+{
+#ifdef HAVE_SETRLIMIT
+  const rlim_t want = this->limit_ + 16;
+
+  struct rlimit rl;
+  if (getrlimit(RLIMIT_NOFILE, &rl) != 0)
+    return;
+  if (rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur < want)
+    {
+      struct rlimit nrl = rl;
+      if (rl.rlim_max == RLIM_INFINITY || rl.rlim_max > want)
+	nrl.rlim_cur = want;
+      else
+	nrl.rlim_cur = rl.rlim_max;
+      if (setrlimit(RLIMIT_NOFILE, &nrl) == 0)
+	rl = nrl;
+    }
+  if (rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur < want)
+    {
+      this->limit_ = static_cast<int>(rl.rlim_cur) - 16;
+      if (this->limit_ < 8)
+	this->limit_ = 8;
+    }
+#endif
+}
+
 // Open a file.
 
 int
@@ -93,6 +134,7 @@ Descriptors::open(int descriptor, const char* name, int flags, int mode)
 	{
 	  gold_assert(!pod->inuse);
 	  pod->inuse = true;
+	  ++this->reuse_count_;
 	  if (descriptor == this->stack_top_)
 	    {
 	      this->stack_top_ = pod->stack_next;
@@ -159,6 +201,7 @@ Descriptors::open(int descriptor, const char* name, int flags, int mode)
 	    pod->is_on_stack = false;
 
 	    ++this->current_;
+	    ++this->open_count_;
 	    if (this->current_ >= this->limit_)
 	      this->close_some_descriptor();
 
@@ -198,6 +241,8 @@ Descriptors::release(int descriptor, bool permanent)
 	gold_warning(_("while closing %s: %s"), pod->name, strerror(errno));
       pod->name = NULL;
       --this->current_;
+      if (!permanent)
+	++this->close_count_;
     }
   else
     {
@@ -233,6 +278,7 @@ Descriptors::close_some_descriptor()
 	  if (::close(i) < 0)
 	    gold_warning(_("while closing %s: %s"), pod->name, strerror(errno));
 	  --this->current_;
+	  ++this->close_count_;
 	  pod->name = NULL;
 	  if (last < 0)
 	    this->stack_top_ = pod->stack_next;
@@ -273,6 +319,21 @@ Descriptors::close_all()
   this->stack_top_ = -1;
 }
 
+// Print statistics to stderr.
+
+void
+Descriptors::print_stats()
+{
+  fprintf(stderr, _("%s: file descriptor limit: %d\n"),
+	  program_name, this->limit_);
+  fprintf(stderr, _("%s: files opened: %u\n"),
+	  program_name, this->open_count_);
+  fprintf(stderr, _("%s: open descriptors reused: %u\n"),
+	  program_name, this->reuse_count_);
+  fprintf(stderr, _("%s: descriptors closed to stay under the limit: %u\n"),
+	  program_name, this->close_count_);
+}
+
 // The single global variable which manages descriptors.
 
 Descriptors descriptors;
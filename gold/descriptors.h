@@ -60,6 +60,16 @@ class Descriptors
   void
   close_all();
 
+  // Print statistics to stderr.
+  void
+  print_stats();
+
+  // Raise the soft limit on open files, and set our own limit to
+  // match.  This is called once at startup, before any threads are
+  // started.
+  void
+  set_limit_from_rlimit();
+
  private:
   // Information kept for a descriptor.
   struct Open_descriptor
@@ -92,6 +102,12 @@ class Descriptors
   int current_;
   // The maximum number of file descriptors we open.
   int limit_;
+  // The number of times we called ::open, for statistics.
+  unsigned int open_count_;
+  // The number of times we reused a descriptor which was still open.
+  unsigned int reuse_count_;
+  // The number of descriptors we closed because we had too many open.
+  unsigned int close_count_;
 };
 
 // File descriptors are a centralized data structure, and we use a
@@ -112,6 +128,14 @@ inline void
 close_all_descriptors()
 { descriptors.close_all(); }
 
+inline void
+set_descriptor_limit()
+{ descriptors.set_limit_from_rlimit(); }
+
+inline void
+print_descriptor_stats()
+{ descriptors.print_stats(); }
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_DESCRIPTORS_H)
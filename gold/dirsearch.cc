@@ -99,7 +99,7 @@ class Dir_caches
 {
  public:
   Dir_caches()
-    : lock_(), caches_()
+    : lock_("dirsearch"), caches_()
   { }
 
   ~Dir_caches();
@@ -984,17 +984,13 @@ Dynobj::sized_create_elf_hash_table(const std::vector<uint32_t>& bucket,
   elfcpp::Swap<32, big_endian>::writeval(p, chaincount);
   p += 4;
 
-  for (unsigned int i = 0; i < bucketcount; ++i)
-    {
-      elfcpp::Swap<32, big_endian>::writeval(p, bucket[i]);
-      p += 4;
-    }
+  if (bucketcount > 0)
+    elfcpp::Swap_block<32, big_endian>::writevals(p, &bucket[0], bucketcount);
+  p += bucketcount * 4;
 
-  for (unsigned int i = 0; i < chaincount; ++i)
-    {
-      elfcpp::Swap<32, big_endian>::writeval(p, chain[i]);
-      p += 4;
-    }
+  if (chaincount > 0)
+    elfcpp::Swap_block<32, big_endian>::writevals(p, &chain[0], chaincount);
+  p += chaincount * 4;
 
   gold_assert(static_cast<unsigned int>(p - phash) == hashlen);
 }
@@ -1261,12 +1257,8 @@ Dynobj::sized_create_gnu_hash_table(
       ++indx[bucket];
     }
 
-  p = phash + 16;
-  for (unsigned int i = 0; i < maskwords; ++i)
-    {
-      elfcpp::Swap<size, big_endian>::writeval(p, bitmask[i]);
-      p += size / 8;
-    }
+  elfcpp::Swap_block<size, big_endian>::writevals(phash + 16, &bitmask[0],
+						  maskwords);
 
   *phashlen = hashlen;
   *pphash = phash;
@@ -39,7 +39,7 @@ namespace gold
 const int Errors::max_undefined_error_report;
 
 Errors::Errors(const char* program_name)
-  : program_name_(program_name), lock_(NULL), initialize_lock_(&this->lock_),
+  : program_name_(program_name), lock_(NULL), initialize_lock_(&this->lock_, "errors"),
     error_count_(0), warning_count_(0), undefined_symbols_()
 {
 }
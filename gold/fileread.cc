@@ -36,6 +36,14 @@
 #include <sys/uio.h>
 #endif
 
+#ifdef HAVE_GETTIMEOFDAY
+#include <sys/time.h>
+#endif
+
+#ifdef HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
+
 #include <sys/stat.h>
 #include "filenames.h"
 
@@ -118,12 +126,47 @@ get_mtime(const char* filename, Timespec* mtime)
 
 // A lock for the File_read static variables.
 static Lock* file_counts_lock = NULL;
-static Initialize_lock file_counts_initialize_lock(&file_counts_lock);
+static Initialize_lock file_counts_initialize_lock(&file_counts_lock,
+						   "file counts");
 
 // The File_read static variables.
 unsigned long long File_read::total_mapped_bytes;
 unsigned long long File_read::current_mapped_bytes;
 unsigned long long File_read::maximum_mapped_bytes;
+unsigned long long File_read::total_prefetched_bytes;
+unsigned long long File_read::total_read_wait_usecs;
+
+// Measure the time spent waiting for a read system call, for
+// --stats.
+
+class Read_wait_timer
+{
+ public:
+  Read_wait_timer()
+#ifdef HAVE_GETTIMEOFDAY
+    : timing_(parameters->options_valid() && parameters->options().stats())
+#else
+    : timing_(false)
+#endif
+  {
+#ifdef HAVE_GETTIMEOFDAY
+    if (this->timing_)
+      gettimeofday(&this->start_, NULL);
+#endif
+  }
+
+  // Add the time since the timer was created to the total.
+  void
+  stop();
+
+ private:
+  // Whether we are timing reads.
+  bool timing_;
+#ifdef HAVE_GETTIMEOFDAY
+  // When the read started.
+  struct timeval start_;
+#endif
+};
 
 // Class File_read::View.
 
@@ -390,6 +433,7 @@ File_read::do_read(off_t start, section_size_type size, void* p)
     {
       this->reopen_descriptor();
 
+      Read_wait_timer timer;
       char *read_ptr = static_cast<char *>(p);
       off_t read_pos = start;
       size_t to_read = size;
@@ -404,7 +448,10 @@ File_read::do_read(off_t start, section_size_type size, void* p)
 	  read_ptr += bytes;
 	  to_read -= bytes;
 	  if (to_read == 0)
-	    return;
+	    {
+	      timer.stop();
+	      return;
+	    }
 	}
       while (bytes > 0);
 
@@ -677,7 +724,9 @@ File_read::do_readv(off_t base, const Read_multiple& rm, size_t start,
     gold_fatal(_("%s: lseek failed: %s"),
 	       this->filename().c_str(), strerror(errno));
 
+  Read_wait_timer timer;
   ssize_t got = ::readv(this->descriptor_, iov, iov_index);
+  timer.stop();
 
   if (got < 0)
     gold_fatal(_("%s: readv failed: %s"),
@@ -845,6 +894,63 @@ File_read::clear_views(Clear_views_mode mode)
     }
 }
 
+// Start reading part of the file into the page cache.  Most input
+// data is read by page faults on mmapped views, one page at a time;
+// telling the kernel which ranges we will need lets it issue larger
+// reads in the background while we work on something else.
+
+void
+File_read::prefetch(off_t start ATTRIBUTE_UNUSED, off_t size ATTRIBUTE_UNUSED)
+{
+#ifdef HAVE_POSIX_FADVISE
+  // A file whose contents we were given in memory has no descriptor.
+  if (this->descriptor_ < 0 || size <= 0 || start >= this->size_)
+    return;
+  this->reopen_descriptor();
+  if (size > this->size_ - start)
+    size = this->size_ - start;
+
+  // Failure is harmless; the data will just be read on demand.
+  if (::posix_fadvise(this->descriptor_, start, size,
+		      POSIX_FADV_WILLNEED) != 0)
+    return;
+
+  if (parameters->options().stats())
+    {
+      file_counts_initialize_lock.initialize();
+      Hold_optional_lock hl(file_counts_lock);
+      File_read::total_prefetched_bytes += size;
+    }
+#endif
+}
+
+// Class Read_wait_timer.
+
+void
+Read_wait_timer::stop()
+{
+#ifdef HAVE_GETTIMEOFDAY
+  if (!this->timing_)
+    return;
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  long long usecs = ((now.tv_sec - this->start_.tv_sec) * 1000000LL
+		     + (now.tv_usec - this->start_.tv_usec));
+  if (usecs > 0)
+    File_read::record_read_wait(usecs);
+#endif
+}
+
+// Add USECS to the time spent waiting for reads.
+
+void
+File_read::record_read_wait(unsigned long long usecs)
+{
+  file_counts_initialize_lock.initialize();
+  Hold_optional_lock hl(file_counts_lock);
+  File_read::total_read_wait_usecs += usecs;
+}
+
 // Print statistical information to stderr.  This is used for --stats.
 
 void
@@ -854,6 +960,18 @@ File_read::print_stats()
 	  program_name, File_read::total_mapped_bytes);
   fprintf(stderr, _("%s: maximum bytes mapped for read at one time: %llu\n"),
 	  program_name, File_read::maximum_mapped_bytes);
+  fprintf(stderr, _("%s: total bytes prefetched: %llu\n"),
+	  program_name, File_read::total_prefetched_bytes);
+  fprintf(stderr, _("%s: time waiting for reads: %llu.%06llu\n"),
+	  program_name, File_read::total_read_wait_usecs / 1000000,
+	  File_read::total_read_wait_usecs % 1000000);
+#ifdef HAVE_GETRUSAGE
+  // Reads of mmapped input files show up as major page faults.
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+    fprintf(stderr, _("%s: major page faults: %ld\n"),
+	    program_name, static_cast<long>(ru.ru_majflt));
+#endif
 }
 
 // Class File_view.
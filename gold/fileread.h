@@ -203,10 +203,21 @@ class File_read
   void
   read_multiple(off_t base, const Read_multiple&);
 
+  // Ask the operating system to start reading SIZE bytes at offset
+  // START into memory, without waiting for the data.  This is only a
+  // hint, and does nothing if the file is not open or the system
+  // does not support it.
+  void
+  prefetch(off_t start, off_t size);
+
   // Dump statistical information to stderr.
   static void
   print_stats();
 
+  // Add USECS spent waiting for a read to the statistics.
+  static void
+  record_read_wait(unsigned long long usecs);
+
   // Return the open file descriptor (for plugins).
   int
   descriptor()
@@ -247,6 +258,13 @@ class File_read
   // --stats.
   static unsigned long long maximum_mapped_bytes;
 
+  // Total bytes for which we requested read-ahead if --stats.
+  static unsigned long long total_prefetched_bytes;
+
+  // Total microseconds spent waiting for read system calls if
+  // --stats.
+  static unsigned long long total_read_wait_usecs;
+
   // A view into the file.
   class View
   {
@@ -22,7 +22,10 @@
 
 #include "gold.h"
 
+#include <cerrno>
 #include <cstring>
+#include <cstdio>
+#include <vector>
 
 #ifdef ENABLE_THREADS
 #include <pthread.h>
@@ -73,12 +76,102 @@ class Lock_impl_nothreads : public Lock_impl
 
 class Condvar_impl_threads;
 
+// The counters for all named locks, in the order in which the names
+// were first seen.  Access to this, and to the counters when atomic
+// builtins are not available, is controlled by lock_stats_control.
+// The entries are never freed, since locks may be destroyed before
+// the statistics are printed.
+
+struct Lock_stats;
+
+static std::vector<Lock_stats*>* lock_stats;
+
+static pthread_mutex_t lock_stats_control = PTHREAD_MUTEX_INITIALIZER;
+
+// Counters for a named lock.  All locks with the same name share one
+// of these, so the counters are not protected by any single lock.
+
+struct Lock_stats
+{
+  Lock_stats(const char* a_name)
+    : name(a_name), acquisitions(0), contentions(0)
+  { }
+
+  // Add one to *PCOUNT.
+  static void
+  increment(unsigned int* pcount)
+  {
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+    __sync_add_and_fetch(pcount, 1);
+#else
+    pthread_mutex_lock(&lock_stats_control);
+    ++*pcount;
+    pthread_mutex_unlock(&lock_stats_control);
+#endif
+  }
+
+  // The name of the lock.
+  const char* name;
+  // The number of times the lock was acquired.
+  unsigned int acquisitions;
+  // The number of times the lock was already held when we tried to
+  // acquire it.
+  unsigned int contentions;
+};
+
+// Return the counters for the lock named NAME.
+
+static Lock_stats*
+get_lock_stats(const char* name)
+{
+  int err = pthread_mutex_lock(&lock_stats_control);
+  if (err != 0)
+    gold_fatal(_("pthread_mutex_lock failed: %s"), strerror(err));
+
+  if (lock_stats == NULL)
+    lock_stats = new std::vector<Lock_stats*>;
+
+  Lock_stats* ret = NULL;
+  for (std::vector<Lock_stats*>::const_iterator p = lock_stats->begin();
+       p != lock_stats->end();
+       ++p)
+    {
+      if (strcmp((*p)->name, name) == 0)
+	{
+	  ret = *p;
+	  break;
+	}
+    }
+  if (ret == NULL)
+    {
+      ret = new Lock_stats(name);
+      lock_stats->push_back(ret);
+    }
+
+  err = pthread_mutex_unlock(&lock_stats_control);
+  if (err != 0)
+    gold_fatal(_("pthread_mutex_unlock failed: %s"), strerror(err));
+
+  return ret;
+}
+
+// The number of times to retry a busy lock before blocking in the
+// kernel, when the pthread library can not do that for us with an
+// adaptive mutex.  Most of the critical sections in gold are only a
+// few instructions long, so a waiting thread on another processor
+// will usually find the lock free again almost immediately.  This is
+// set by Lock::set_cpu_count before any threads are started, and is
+// zero on a uniprocessor, where the holder can not run until we give
+// up the processor.
+
+static int lock_spin_count;
+
 // The threaded version of Lock_impl.
 
 class Lock_impl_threads : public Lock_impl
 {
  public:
-  Lock_impl_threads();
+  Lock_impl_threads(Lock_stats*);
   ~Lock_impl_threads();
 
   void acquire();
@@ -93,18 +186,27 @@ private:
   friend class Condvar_impl_threads;
 
   pthread_mutex_t mutex_;
+  // The counters for this lock, or NULL if it is not being tracked.
+  Lock_stats* stats_;
+  // The number of times to retry the lock before blocking.
+  int spin_count_;
 };
 
-Lock_impl_threads::Lock_impl_threads()
+Lock_impl_threads::Lock_impl_threads(Lock_stats* stats)
+  : stats_(stats), spin_count_(0)
 {
   pthread_mutexattr_t attr;
   int err = pthread_mutexattr_init(&attr);
   if (err != 0)
     gold_fatal(_("pthead_mutextattr_init failed: %s"), strerror(err));
 #ifdef PTHREAD_MUTEX_ADAPTIVE_NP
-  err = pthread_mutextattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+  err = pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
   if (err != 0)
     gold_fatal(_("pthread_mutextattr_settype failed: %s"), strerror(err));
+#else
+  // An adaptive mutex already spins before blocking, so only spin
+  // ourselves when we don't have one.
+  this->spin_count_ = lock_spin_count;
 #endif
 
   err = pthread_mutex_init(&this->mutex_, &attr);
@@ -123,12 +225,32 @@ Lock_impl_threads::~Lock_impl_threads()
     gold_fatal(_("pthread_mutex_destroy failed: %s"), strerror(err));
 }
 
+// Acquire the lock.  Try to take it without blocking first, so that
+// contention can be counted, and spin for a little while if it is
+// busy and the mutex is not adaptive.
+
 void
 Lock_impl_threads::acquire()
 {
-  int err = pthread_mutex_lock(&this->mutex_);
+  int err = pthread_mutex_trylock(&this->mutex_);
+  if (err == EBUSY)
+    {
+      if (this->stats_ != NULL)
+	Lock_stats::increment(&this->stats_->contentions);
+      for (int i = 0; i < this->spin_count_ && err == EBUSY; ++i)
+	{
+#if defined(__i386__) || defined(__x86_64__)
+	  __asm__ __volatile__("pause" : : : "memory");
+#endif
+	  err = pthread_mutex_trylock(&this->mutex_);
+	}
+      if (err == EBUSY)
+	err = pthread_mutex_lock(&this->mutex_);
+    }
   if (err != 0)
     gold_fatal(_("pthread_mutex_lock failed: %s"), strerror(err));
+  if (this->stats_ != NULL)
+    Lock_stats::increment(&this->stats_->acquisitions);
 }
 
 void
@@ -143,20 +265,65 @@ Lock_impl_threads::release()
 
 // Class Lock.
 
+// Set the number of CPUs, which determines whether locks spin when
+// they are busy.
+
+void
+Lock::set_cpu_count(int cpus ATTRIBUTE_UNUSED)
+{
+#ifdef ENABLE_THREADS
+  lock_spin_count = cpus > 1 ? 100 : 0;
+#endif
+}
+
 Lock::Lock()
+{
+  this->init(NULL);
+}
+
+Lock::Lock(const char* name)
+{
+  this->init(name);
+}
+
+// Create the implementation.  Only threaded locks are tracked, since
+// a lock can never be contended without threads.
+
+void
+Lock::init(const char* name)
 {
   if (!parameters->options().threads())
     this->lock_ = new Lock_impl_nothreads;
   else
     {
 #ifdef ENABLE_THREADS
-      this->lock_ = new Lock_impl_threads;
+      Lock_stats* stats = NULL;
+      if (name != NULL && parameters->options().stats())
+	stats = get_lock_stats(name);
+      this->lock_ = new Lock_impl_threads(stats);
 #else
       gold_unreachable();
 #endif
     }
 }
 
+// Print the counters for the named locks.  This is called after all
+// the worker threads have finished.
+
+void
+Lock::print_stats()
+{
+#ifdef ENABLE_THREADS
+  if (lock_stats == NULL)
+    return;
+  for (std::vector<Lock_stats*>::const_iterator p = lock_stats->begin();
+       p != lock_stats->end();
+       ++p)
+    fprintf(stderr, _("%s: %s lock: %u acquisitions, %u contended\n"),
+	    program_name, (*p)->name, (*p)->acquisitions, (*p)->contentions);
+#endif
+}
+
 Lock::~Lock()
 {
   delete this->lock_;
@@ -444,7 +611,7 @@ Initialize_lock::initialize()
 void
 Initialize_lock::do_run_once(void*)
 {
-  *this->pplock_ = new Lock();
+  *this->pplock_ = new Lock(this->name_);
 }
 
 } // End namespace gold.
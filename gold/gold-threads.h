@@ -64,6 +64,11 @@ class Lock
  public:
   Lock();
 
+  // Create a lock with a name.  When --stats is used, the number of
+  // times each named lock was acquired and found busy is reported.
+  // Locks which share a name share their counters.
+  explicit Lock(const char* name);
+
   ~Lock();
 
   // Acquire the lock.
@@ -76,11 +81,24 @@ class Lock
   release()
   { this->lock_->release(); }
 
+  // Print the contention statistics of the named locks.
+  static void
+  print_stats();
+
+  // Tell the lock implementation how many CPUs there are.  This must
+  // be called before any threads are started, and only affects locks
+  // created afterward.
+  static void
+  set_cpu_count(int);
+
  private:
   // This class can not be copied.
   Lock(const Lock&);
   Lock& operator=(const Lock&);
 
+  void
+  init(const char* name);
+
   friend class Condvar;
   Lock_impl*
   get_impl() const
@@ -243,9 +261,10 @@ class Initialize_lock : public Once
 {
  public:
   // The class which uses this will have a pointer to a lock.  This
-  // must be constructed with a pointer to that pointer.
-  Initialize_lock(Lock** pplock)
-    : pplock_(pplock)
+  // must be constructed with a pointer to that pointer.  NAME, if
+  // not NULL, is the name given to the lock for --stats.
+  Initialize_lock(Lock** pplock, const char* name = NULL)
+    : pplock_(pplock), name_(name)
   { }
 
   // Initialize the lock.  Return true if the lock is now initialized,
@@ -260,6 +279,8 @@ class Initialize_lock : public Once
  private:
   // A pointer to the lock pointer which must be initialized.
   Lock** const pplock_;
+  // The name of the lock, or NULL.
+  const char* name_;
 };
 
 } // End namespace gold.
@@ -28,6 +28,7 @@
 #include <unistd.h>
 #include <algorithm>
 #include "libiberty.h"
+#include "demangle.h"
 
 #include "options.h"
 #include "target-select.h"
@@ -46,6 +47,7 @@
 #include "icf.h"
 #include "incremental.h"
 #include "timer.h"
+#include "gold-threads.h"
 
 namespace gold
 {
@@ -102,6 +104,129 @@ do_gold_unreachable(const char* filename, int lineno, const char* function)
   gold_exit(GOLD_ERR);
 }
 
+// The cache used by cplus_demangle_cached.  It is keyed on the
+// address of the name, which is always a name in the symbol table's
+// string pool and so is not freed while we are linking.  The value is
+// the result of cplus_demangle, which is NULL if the name can not be
+// demangled; we remember those too, so that C names are not passed to
+// the demangler again each time they are looked up.
+
+struct Demangle_cache_hash
+{
+  size_t
+  operator()(const char* name) const
+  { return reinterpret_cast<uintptr_t>(name); }
+};
+
+typedef Unordered_map<const char*, char*, Demangle_cache_hash> Demangle_cache;
+
+// To bound the memory used by the cache we keep two generations of
+// entries.  New entries go into demangle_cache_new.  When that holds
+// demangle_cache_limit entries, the old generation is freed and the
+// new one takes its place.  A name found in the old generation is
+// moved back to the new one, so names which are still being used are
+// not lost.
+
+static Demangle_cache* demangle_cache_new;
+static Demangle_cache* demangle_cache_old;
+
+static const size_t demangle_cache_limit = 50000;
+
+// A lock for the demangle cache.
+static Lock* demangle_cache_lock = NULL;
+static Initialize_lock demangle_cache_initialize_lock(&demangle_cache_lock);
+
+// Free the entries in CACHE, and CACHE itself.
+
+static void
+demangle_cache_free(Demangle_cache* cache)
+{
+  if (cache == NULL)
+    return;
+  for (Demangle_cache::iterator p = cache->begin(); p != cache->end(); ++p)
+    free(p->second);
+  delete cache;
+}
+
+// Add NAME with demangled form RESULT to the new generation of the
+// demangle cache.  This is called with the lock held.
+
+static void
+demangle_cache_add(const char* name, char* result)
+{
+  if (demangle_cache_new == NULL)
+    demangle_cache_new = new Demangle_cache();
+  else if (demangle_cache_new->size() >= demangle_cache_limit)
+    {
+      demangle_cache_free(demangle_cache_old);
+      demangle_cache_old = demangle_cache_new;
+      demangle_cache_new = new Demangle_cache();
+    }
+  (*demangle_cache_new)[name] = result;
+}
+
+// Set *DEMANGLED to the demangled form of NAME, using the cache.
+
+bool
+cplus_demangle_cached(const char* name, std::string* demangled)
+{
+  // We can only use the lock once the options have been read.  Before
+  // that point there is only one thread.
+  demangle_cache_initialize_lock.initialize();
+
+  {
+    Hold_optional_lock hl(demangle_cache_lock);
+    Demangle_cache::iterator p;
+    if (demangle_cache_new != NULL
+	&& (p = demangle_cache_new->find(name)) != demangle_cache_new->end())
+      {
+	if (p->second == NULL)
+	  return false;
+	*demangled = p->second;
+	return true;
+      }
+    if (demangle_cache_old != NULL
+	&& (p = demangle_cache_old->find(name)) != demangle_cache_old->end())
+      {
+	char* result = p->second;
+	demangle_cache_old->erase(p);
+	demangle_cache_add(name, result);
+	if (result == NULL)
+	  return false;
+	*demangled = result;
+	return true;
+      }
+  }
+
+  // Demangle without holding the lock.
+  char* result = cplus_demangle(name, DMGL_ANSI | DMGL_PARAMS);
+  bool ret = result != NULL;
+  if (ret)
+    *demangled = result;
+
+  Hold_optional_lock hl(demangle_cache_lock);
+  // Another thread may have added NAME while we were demangling.
+  if (demangle_cache_new == NULL
+      || demangle_cache_new->find(name) == demangle_cache_new->end())
+    demangle_cache_add(name, result);
+  else
+    free(result);
+  return ret;
+}
+
+// Free the memory used by the cache for cplus_demangle_cached.
+
+void
+cplus_demangle_cache_clear()
+{
+  demangle_cache_initialize_lock.initialize();
+  Hold_optional_lock hl(demangle_cache_lock);
+  demangle_cache_free(demangle_cache_new);
+  demangle_cache_free(demangle_cache_old);
+  demangle_cache_new = NULL;
+  demangle_cache_old = NULL;
+}
+
 // This class arranges to run the functions done in the middle of the
 // link.  It is just a closure.
 
@@ -192,8 +317,9 @@ queue_initial_tasks(const General_options& options,
 
   int thread_count = options.thread_count_initial();
   if (thread_count == 0)
-    thread_count = cmdline.number_of_input_files();
-  workqueue->set_thread_count(thread_count);
+    workqueue->set_adaptive_thread_count(cmdline.number_of_input_files());
+  else
+    workqueue->set_thread_count(thread_count);
 
   // For incremental links, the base output file.
   Incremental_binary* ibase = NULL;
@@ -495,6 +621,10 @@ queue_middle_tasks(const General_options& options,
   // Add any symbols named with -u options to the symbol table.
   symtab->add_undefined_symbols_from_command_line(layout);
 
+  // All the input symbols have been matched against the version
+  // script, so the demangled names are unlikely to be needed again.
+  cplus_demangle_cache_clear();
+
   // If garbage collection was chosen, relocs have been read and processed
   // at this point by pre_middle_tasks.  Layout can then be done for all
   // objects.
@@ -596,8 +726,10 @@ queue_middle_tasks(const General_options& options,
 
   int thread_count = options.thread_count_middle();
   if (thread_count == 0)
-    thread_count = std::max(2, input_objects->number_of_input_objects());
-  workqueue->set_thread_count(thread_count);
+    workqueue->set_adaptive_thread_count(
+	std::max(2, input_objects->number_of_input_objects()));
+  else
+    workqueue->set_thread_count(thread_count);
 
   // Now we have seen all the input files.
   const bool doing_static_link =
@@ -797,8 +929,10 @@ queue_final_tasks(const General_options& options,
 
   int thread_count = options.thread_count_final();
   if (thread_count == 0)
-    thread_count = std::max(2, input_objects->number_of_input_objects());
-  workqueue->set_thread_count(thread_count);
+    workqueue->set_adaptive_thread_count(
+	std::max(2, input_objects->number_of_input_objects()));
+  else
+    workqueue->set_thread_count(thread_count);
 
   bool any_postprocessing_sections = layout->any_postprocessing_sections();
 
@@ -241,6 +241,19 @@ queue_final_tasks(const General_options&,
 		  Workqueue*,
 		  Output_file* of);
 
+// Set *DEMANGLED to the C++ demangled form of NAME, as computed by
+// cplus_demangle with DMGL_ANSI | DMGL_PARAMS, and return true, or
+// return false if NAME can not be demangled.  Results are cached, so
+// that the version script code and the symbol table share the work of
+// demangling a name.  The cache is keyed on the address of NAME, so
+// NAME must be a name in the symbol table's string pool.
+extern bool
+cplus_demangle_cached(const char* name, std::string* demangled);
+
+// Free the cache used by cplus_demangle_cached.
+extern void
+cplus_demangle_cache_clear();
+
 inline bool
 is_prefix_of(const char* prefix, const char* str)
 {
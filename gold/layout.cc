@@ -424,7 +424,10 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     namepool_(),
     sympool_(),
     dynpool_(),
+    signature_pool_(),
     signatures_(),
+    signatures_lock_(NULL),
+    signatures_initialize_lock_(&this->signatures_lock_, "signatures"),
     section_name_map_(),
     segment_list_(),
     section_list_(),
@@ -463,7 +466,6 @@ Layout::Layout(int number_of_input_files, Script_options* script_options)
     input_without_gnu_stack_note_(false),
     has_static_tls_(false),
     any_postprocessing_sections_(false),
-    resized_signatures_(false),
     have_stabstr_section_(false),
     section_ordering_specified_(false),
     unique_segment_for_sections_specified_(false),
@@ -5107,54 +5109,53 @@ Layout::match_file_name(const Relobj* relobj, const char* match)
 // true.
 
 bool
-Layout::find_or_add_kept_section(const std::string& name,
+Layout::find_or_add_kept_section(const char* name,
 				 Relobj* object,
 				 unsigned int shndx,
 				 bool is_comdat,
 				 bool is_group_name,
 				 Kept_section** kept_section)
 {
-  // It's normal to see a couple of entries here, for the x86 thunk
-  // sections.  If we see more than a few, we're linking a C++
-  // program, and we resize to get more space to minimize rehashing.
-  if (this->signatures_.size() > 4
-      && !this->resized_signatures_)
-    {
-      reserve_unordered_map(&this->signatures_,
-			    this->number_of_input_files_ * 64);
-      this->resized_signatures_ = true;
-    }
+  this->signatures_initialize_lock_.initialize();
+  Hold_optional_lock hl(this->signatures_lock_);
+
+  // Interning the name computes its hash code once, and gives us a
+  // key which indexes signatures_ directly.
+  Stringpool::Key key;
+  this->signature_pool_.add(name, true, &key);
+  gold_assert(key > 0 && key <= this->signatures_.size() + 1);
 
-  Kept_section candidate;
-  std::pair<Signatures::iterator, bool> ins =
-    this->signatures_.insert(std::make_pair(name, candidate));
+  bool is_new = key > this->signatures_.size();
+  if (is_new)
+    this->signatures_.push_back(Kept_section());
+  Kept_section* kept = &this->signatures_[key - 1];
 
   if (kept_section != NULL)
-    *kept_section = &ins.first->second;
-  if (ins.second)
+    *kept_section = kept;
+  if (is_new)
     {
       // This is the first time we've seen this signature.
-      ins.first->second.set_object(object);
-      ins.first->second.set_shndx(shndx);
+      kept->set_object(object);
+      kept->set_shndx(shndx);
       if (is_comdat)
-	ins.first->second.set_is_comdat();
+	kept->set_is_comdat();
       if (is_group_name)
-	ins.first->second.set_is_group_name();
+	kept->set_is_group_name();
       return true;
     }
 
   // We have already seen this signature.
 
-  if (ins.first->second.is_group_name())
+  if (kept->is_group_name())
     {
       // We've already seen a real section group with this signature.
       // If the kept group is from a plugin object, and we're in the
       // replacement phase, accept the new one as a replacement.
-      if (ins.first->second.object() == NULL
+      if (kept->object() == NULL
 	  && parameters->options().plugins()->in_replacement_phase())
 	{
-	  ins.first->second.set_object(object);
-	  ins.first->second.set_shndx(shndx);
+	  kept->set_object(object);
+	  kept->set_shndx(shndx);
 	  return true;
 	}
       return false;
@@ -5164,7 +5165,7 @@ Layout::find_or_add_kept_section(const std::string& name,
       // This is a real section group, and we've already seen a
       // linkonce section with this signature.  Record that we've seen
       // a section group, and don't include this section group.
-      ins.first->second.set_is_group_name();
+      kept->set_is_group_name();
       return false;
     }
   else
@@ -24,6 +24,7 @@
 #define GOLD_LAYOUT_H
 
 #include <cstring>
+#include <deque>
 #include <list>
 #include <map>
 #include <string>
@@ -775,9 +776,10 @@ class Layout
   // returns false.  Otherwise, OBJECT, SHNDX,IS_COMDAT, and
   // IS_GROUP_NAME are recorded for this NAME in the layout object,
   // *KEPT_SECTION is set to the internal copy and the function return
-  // false.
+  // false.  This may be called from several tasks at once; the first
+  // caller for a given NAME wins.
   bool
-  find_or_add_kept_section(const std::string& name, Relobj* object,
+  find_or_add_kept_section(const char* name, Relobj* object,
 			   unsigned int shndx, bool is_comdat,
 			   bool is_group_name, Kept_section** kept_section);
 
@@ -1234,8 +1236,12 @@ class Layout
 		       Output_segment*, Output_segment_headers*,
 		       Output_file_header*, unsigned int*);
 
-  // A mapping used for kept comdats/.gnu.linkonce group signatures.
-  typedef Unordered_map<std::string, Kept_section> Signatures;
+  // The kept comdats/.gnu.linkonce group signatures.  The signature
+  // strings are interned in signature_pool_, which hands out keys
+  // sequentially starting at 1, so the Kept_section for the signature
+  // with key K is element K - 1.  A deque never moves its elements
+  // when it grows, so pointers to them remain valid.
+  typedef std::deque<Kept_section> Signatures;
 
   // Mapping from input section name/type/flags to output section.  We
   // use canonicalized strings here.
@@ -1320,8 +1326,16 @@ class Layout
   Stringpool sympool_;
   // The dynamic strings, if needed.
   Stringpool dynpool_;
-  // The list of group sections and linkonce sections which we have seen.
+  // The signatures of the group sections and linkonce sections which
+  // we have seen.
+  Stringpool signature_pool_;
+  // The list of group sections and linkonce sections which we have
+  // seen, indexed by signature_pool_ key.
   Signatures signatures_;
+  // A lock for signature_pool_ and signatures_.
+  Lock* signatures_lock_;
+  // Used to initialize signatures_lock_ once the options are known.
+  Initialize_lock signatures_initialize_lock_;
   // The mapping from input section name/type/flags to output sections.
   Section_name_map section_name_map_;
   // The list of output segments.
@@ -1405,8 +1419,6 @@ class Layout
   bool has_static_tls_;
   // Whether any sections require postprocessing.
   bool any_postprocessing_sections_;
-  // Whether we have resized the signatures_ hash table.
-  bool resized_signatures_;
   // Whether we have created a .stab*str output section.
   bool have_stabstr_section_;
   // True if the input sections in the output sections should be sorted
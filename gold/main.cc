@@ -38,6 +38,7 @@
 #include "errors.h"
 #include "mapfile.h"
 #include "dirsearch.h"
+#include "descriptors.h"
 #include "workqueue.h"
 #include "object.h"
 #include "archive.h"
@@ -174,6 +175,9 @@ main(int argc, char** argv)
   // Store some options in the globally accessible parameters.
   set_parameters_options(&command_line.options());
 
+  // Keep as many input files open as the system permits.
+  set_descriptor_limit();
+
   // Do this as early as possible (since it prints a welcome message).
   write_debug_script(command_line.options().output_file_name(),
                      program_name, args.c_str());
@@ -296,6 +300,9 @@ main(int argc, char** argv)
 	      program_name, m.arena);
 #endif
       File_read::print_stats();
+      Lock::print_stats();
+      workqueue.print_stats();
+      print_descriptor_stats();
       Archive::print_stats();
       Lib_group::print_stats();
       fprintf(stderr, _("%s: output file size: %lld bytes\n"),
@@ -25,6 +25,7 @@
 #include <cerrno>
 #include <cstring>
 #include <cstdarg>
+#include <algorithm>
 #include "demangle.h"
 #include "libiberty.h"
 
@@ -124,13 +125,16 @@ Xindex::read_symtab_xindex(Object* object, unsigned int xindex_shndx,
     }
 
   gold_assert(this->symtab_xindex_.empty());
-  this->symtab_xindex_.reserve(bytecount / 4);
-  for (section_size_type i = 0; i < bytecount; i += 4)
-    {
-      unsigned int shndx = elfcpp::Swap<32, big_endian>::readval(contents + i);
-      // We preadjust the section indexes we save.
-      this->symtab_xindex_.push_back(this->adjust_shndx(shndx));
-    }
+  const section_size_type count = bytecount / 4;
+  if (count == 0)
+    return;
+  this->symtab_xindex_.resize(count);
+  elfcpp::Swap_block<32, big_endian>::readvals(contents,
+					       &this->symtab_xindex_[0],
+					       count);
+  // We preadjust the section indexes we save.
+  for (section_size_type i = 0; i < count; ++i)
+    this->symtab_xindex_[i] = this->adjust_shndx(this->symtab_xindex_[i]);
 }
 
 // Symbol symndx has a section of SHN_XINDEX; return the real section
@@ -848,6 +852,102 @@ Sized_relobj_file<size, big_endian>::base_read_symbols(Read_symbols_data* sd)
   sd->symbol_names = fvstrtab;
   sd->symbol_names_size =
     convert_to_section_size_type(strtabshdr.get_sh_size());
+
+  // Only now, with the symbols in hand, start reading what later
+  // tasks will need, so that the read ahead does not compete with
+  // the reads we are waiting for.
+  this->prefetch_sections(sd);
+}
+
+// Ask the system to start reading the sections which we will need
+// after reading the symbols: the relocations, which are scanned next,
+// the allocated sections, which are copied to the output file, and
+// the debugging sections, compressed or not, if we are going to copy
+// or index them.  By the time we get to those tasks, the data should
+// already be in memory.  We request at most --prefetch-window bytes.
+// For a small object the kernel's own read ahead on the first page
+// fault does as well, so we don't bother.
+
+template<int size, bool big_endian>
+void
+Sized_relobj_file<size, big_endian>::prefetch_sections(Read_symbols_data* sd)
+{
+  uint64_t window = parameters->options().prefetch_window();
+  if (window == 0)
+    return;
+
+  const bool want_debug = (parameters->options().gdb_index()
+			   || !parameters->options().strip_debug());
+  const unsigned char* pnames = sd->section_names->data();
+  const section_size_type names_size = sd->section_names_size;
+
+  // The ranges to read, as offset and end, and their total size.
+  std::vector<std::pair<off_t, off_t> > ranges;
+  uint64_t total = 0;
+  const unsigned int shnum = this->shnum();
+  const unsigned char* p = sd->section_headers->data() + This::shdr_size;
+  for (unsigned int i = 1; i < shnum; ++i, p += This::shdr_size)
+    {
+      typename This::Shdr shdr(p);
+      const unsigned int sh_type = shdr.get_sh_type();
+      if (sh_type == elfcpp::SHT_NOBITS || shdr.get_sh_size() == 0)
+	continue;
+
+      bool want;
+      if (sh_type == elfcpp::SHT_REL || sh_type == elfcpp::SHT_RELA)
+	want = true;
+      else if ((shdr.get_sh_flags() & elfcpp::SHF_ALLOC) != 0)
+	want = true;
+      else if (want_debug && shdr.get_sh_name() < names_size)
+	{
+	  const char* name = (reinterpret_cast<const char*>(pnames)
+			      + shdr.get_sh_name());
+	  want = (is_prefix_of(".debug_", name)
+		  || is_prefix_of(".zdebug_", name));
+	}
+      else
+	want = false;
+
+      if (want)
+	{
+	  off_t start = shdr.get_sh_offset();
+	  ranges.push_back(std::make_pair(start, start + shdr.get_sh_size()));
+	  total += shdr.get_sh_size();
+	}
+    }
+
+  const uint64_t min_prefetch = 64 * 1024;
+  if (total < min_prefetch)
+    return;
+
+  // Sections are usually in file order, but make sure, and merge
+  // ranges which are close together into a single request.
+  std::sort(ranges.begin(), ranges.end());
+  const off_t max_gap = 4096;
+  off_t start = ranges[0].first;
+  off_t end = ranges[0].second;
+  for (size_t i = 1; i <= ranges.size() && window > 0; ++i)
+    {
+      if (i < ranges.size()
+	  && ranges[i].first <= end + max_gap)
+	{
+	  if (ranges[i].second > end)
+	    end = ranges[i].second;
+	  continue;
+	}
+
+      off_t len = end - start;
+      if (static_cast<uint64_t>(len) > window)
+	len = window;
+      this->prefetch(start, len);
+      window -= len;
+
+      if (i < ranges.size())
+	{
+	  start = ranges[i].first;
+	  end = ranges[i].second;
+	}
+    }
 }
 
 // Return the section index of symbol SYM.  Set *VALUE to its value in
@@ -946,7 +1046,7 @@ Sized_relobj_file<size, big_endian>::include_section_group(
       return false;
     }
 
-  std::string signature(psymnames + sym.get_st_name());
+  const char* signature = psymnames + sym.get_st_name();
 
   // It seems that some versions of gas will create a section group
   // associated with a section symbol, and then fail to give a name to
@@ -991,7 +1091,7 @@ Sized_relobj_file<size, big_endian>::include_section_group(
     {
       Incremental_inputs* incremental_inputs = layout->incremental_inputs();
       if (incremental_inputs != NULL)
-	incremental_inputs->report_comdat_group(this, signature.c_str());
+	incremental_inputs->report_comdat_group(this, signature);
     }
 
   size_t count = shdr.get_sh_size() / sizeof(elfcpp::Elf_Word);
@@ -1083,7 +1183,7 @@ Sized_relobj_file<size, big_endian>::include_section_group(
     }
 
   if (relocate_group)
-    layout->layout_group(symtab, this, index, name, signature.c_str(),
+    layout->layout_group(symtab, this, index, name, signature,
 			 shdr, flags, &shndxes);
 
   return include_group;
@@ -1127,13 +1227,11 @@ Sized_relobj_file<size, big_endian>::include_linkonce_section(
     symname = name + strlen(linkonce_t);
   else
     symname = strrchr(name, '.') + 1;
-  std::string sig1(symname);
-  std::string sig2(name);
   Kept_section* kept1;
   Kept_section* kept2;
-  bool include1 = layout->find_or_add_kept_section(sig1, this, index, false,
-						   false, &kept1);
-  bool include2 = layout->find_or_add_kept_section(sig2, this, index, false,
+  bool include1 = layout->find_or_add_kept_section(symname, this, index,
+						   false, false, &kept1);
+  bool include2 = layout->find_or_add_kept_section(name, this, index, false,
 						   true, &kept2);
 
   if (!include2)
@@ -2103,6 +2201,17 @@ Sized_relobj_file<size, big_endian>::do_count_local_symbols(Stringpool* pool,
   const unsigned char* psyms = this->get_view(symtabshdr.get_sh_offset(),
 					      locsize, true, true);
 
+  // The loop below reads nearly every field of every local symbol.
+  // For a cross-endian link, convert them all to host order first.
+  std::vector<unsigned char> host_syms;
+  if (big_endian != elfcpp::Endian::host_big_endian && loccount > 0)
+    {
+      host_syms.resize(locsize);
+      elfcpp::Sym_block<size, big_endian>::readvals(psyms, &host_syms[0],
+						     loccount);
+      psyms = &host_syms[0];
+    }
+
   // Read the symbol names.
   const unsigned int strtab_shndx =
     this->adjust_shndx(symtabshdr.get_sh_link());
@@ -2125,7 +2234,7 @@ Sized_relobj_file<size, big_endian>::do_count_local_symbols(Stringpool* pool,
   bool discard_locals = parameters->options().discard_locals();
   for (unsigned int i = 1; i < loccount; ++i, psyms += sym_size)
     {
-      elfcpp::Sym<size, big_endian> sym(psyms);
+      elfcpp::Sym<size, elfcpp::Endian::host_big_endian> sym(psyms);
 
       Symbol_value<size>& lv(this->local_values_[i]);
 
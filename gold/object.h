@@ -666,6 +666,11 @@ class Object
   read(off_t start, section_size_type size, void* p)
   { this->input_file()->file().read(start + this->offset_, size, p); }
 
+  // Start reading data from the underlying file, without waiting.
+  void
+  prefetch(off_t start, off_t size)
+  { this->input_file()->file().prefetch(start + this->offset_, size); }
+
   // Read multiple data from the underlying file.
   void
   read_multiple(const File_read::Read_multiple& rm)
@@ -2219,6 +2224,10 @@ class Sized_relobj_file : public Sized_relobj<size, big_endian>
   void
   base_read_symbols(Read_symbols_data*);
 
+  // Start reading the sections we will need later.
+  void
+  prefetch_sections(Read_symbols_data*);
+
   // Return the value of a local symbol.
   uint64_t
   do_local_symbol_value(unsigned int symndx, uint64_t addend) const
@@ -1006,6 +1006,10 @@ class General_options
 		 " (default)."),
 	      N_("Use fallocate or ftruncate to reserve space."));
 
+  DEFINE_uint64(prefetch_window, options::TWO_DASHES, '\0', 16 << 20,
+		N_("Read ahead up to SIZE bytes of sections of each input"
+		   " object (0 to disable)"), N_("SIZE"));
+
   DEFINE_bool(preread_archive_symbols, options::TWO_DASHES, '\0', false,
 	      N_("Preread archive symbols when multi-threaded"), NULL);
 
@@ -1007,7 +1007,7 @@ Pluginobj::include_comdat_group(std::string comdat_key, Layout* layout)
   // If this is the first time we've seen this comdat key, ask the
   // layout object whether it should be included.
   if (ins.second)
-    ins.first->second = layout->find_or_add_kept_section(comdat_key,
+    ins.first->second = layout->find_or_add_kept_section(comdat_key.c_str(),
 							 NULL, 0, true,
 							 true, NULL);
 
@@ -122,7 +122,7 @@ Read_symbols::requeue(Workqueue* workqueue, Input_objects* input_objects,
   // reached it.  However, we are removing the blocker on next_blocker
   // because the calling task is completing.  So we need to add a new
   // blocker.  Since next_blocker may be shared by several tasks, we
-  // need to increment the count with the workqueue lock held.
+  // need to increment the count through the workqueue.
   workqueue->add_blocker(next_blocker);
 
   workqueue->queue(new Read_symbols(input_objects, symtab, layout, dirpath,
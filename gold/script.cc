@@ -370,18 +370,12 @@ Lex::read_file(Input_file* input_file, std::string* contents)
 {
   off_t filesize = input_file->file().filesize();
   contents->clear();
-  contents->reserve(filesize);
 
-  off_t off = 0;
-  unsigned char buf[BUFSIZ];
-  while (off < filesize)
+  // Read the whole file at once; generated scripts can be large.
+  if (filesize > 0)
     {
-      off_t get = BUFSIZ;
-      if (get > filesize - off)
-	get = filesize - off;
-      input_file->file().read(off, get, buf);
-      contents->append(reinterpret_cast<char*>(&buf[0]), get);
-      off += get;
+      contents->resize(filesize);
+      input_file->file().read(0, filesize, &(*contents)[0]);
     }
 }
 
@@ -1583,6 +1577,18 @@ read_script_file(const char* filename, Command_line* cmdline,
   std::string input_string;
   Lex::read_file(&input_file, &input_string);
 
+  // Version scripts and dynamic lists which are just lists of symbols
+  // can be handled without the general parser.
+  if ((first_token == PARSING_VERSION_SCRIPT
+       || first_token == PARSING_DYNAMIC_LIST)
+      && read_plain_symbol_list(input_string.c_str(), input_string.length(),
+				first_token == PARSING_DYNAMIC_LIST,
+				script_options->version_script_info()))
+    {
+      input_file.file().unlock(task);
+      return true;
+    }
+
   Lex lex(input_string.c_str(), input_string.length(), first_token);
   lex.set_mode(lex_mode);
 
@@ -1641,6 +1647,28 @@ read_dynamic_list(const char* filename, Command_line* cmdline,
                           PARSING_DYNAMIC_LIST, Lex::DYNAMIC_LIST);
 }
 
+// Parse INPUT, the contents of a version script or a dynamic list,
+// with the general parser, and store the result in SCRIPT_OPTIONS.
+// This does not try read_plain_symbol_list first; it is used to check
+// that the two parsers agree.
+
+bool
+read_symbol_list_script(const char* filename, const char* input,
+			size_t length, bool is_dynamic_list,
+			Script_options* script_options)
+{
+  Lex lex(input, length,
+	  is_dynamic_list ? PARSING_DYNAMIC_LIST : PARSING_VERSION_SCRIPT);
+  lex.set_mode(is_dynamic_list ? Lex::DYNAMIC_LIST : Lex::VERSION_SCRIPT);
+
+  // Dummy value.
+  Position_dependent_options posdep_options;
+
+  Parser_closure closure(filename, posdep_options, false, false, false,
+			 NULL, script_options, &lex, false, NULL);
+  return yyparse(&closure) == 0;
+}
+
 // Implement the --defsym option on the command line.  Return true if
 // all is well.
 
@@ -1937,22 +1965,360 @@ struct Version_tree
   const struct Version_dependency_list* dependencies;
 };
 
+// A fast parser for version scripts and dynamic lists which are plain
+// lists of symbols, such as
+//   VERS_1 { global: foo; bar*; local: *; };
+// or
+//   { foo; bar; };
+// Large generated scripts almost always have this shape, and running
+// them through the bison parser takes a long time.  The input is
+// tokenized by Lex in the same mode, and keywords are looked up in the
+// same tables, as for the bison parser.  The grammar accepted is a
+// strict subset of the version_script and dynamic_list_expr rules in
+// yyscript.y: on any other token, such as "extern", or on a syntax
+// error, this gives up and the caller falls back to the general
+// parser, which produces the proper diagnostics.  Nothing is recorded
+// in the Version_script_info unless the whole input is accepted.
+
+class Symbol_list_parser
+{
+ public:
+  // INPUT must be null terminated, as for Lex.
+  Symbol_list_parser(const char* input, size_t length, bool is_dynamic_list)
+    : lex_(input, length, 0), is_dynamic_list_(is_dynamic_list),
+      keywords_(is_dynamic_list
+		? &dynamic_list_keywords
+		: &version_script_keywords),
+      nodes_(), token_(NULL), parsecode_(0)
+  {
+    this->lex_.set_mode(is_dynamic_list
+			? Lex::DYNAMIC_LIST
+			: Lex::VERSION_SCRIPT);
+  }
+
+  // Parse the input.  Return true if it was accepted.
+  bool
+  parse();
+
+  // Record the parsed version nodes in VSI.
+  void
+  record(Version_script_info* vsi) const;
+
+ private:
+  // A pattern in a symbol list.
+  struct Pattern
+  {
+    Pattern(const char* v, size_t l, bool e)
+      : value(v), length(l), exact_match(e)
+    { }
+
+    const char* value;
+    size_t length;
+    bool exact_match;
+  };
+
+  typedef std::vector<Pattern> Patterns;
+
+  // A single version node.
+  struct Node
+  {
+    Node()
+      : tag(NULL), taglen(0), global(), local(), deps()
+    { }
+
+    const char* tag;
+    size_t taglen;
+    Patterns global;
+    Patterns local;
+    std::vector<std::pair<const char*, size_t> > deps;
+  };
+
+  // Read the next token, and look up keywords the way yylex does.
+  void
+  next_token();
+
+  // Return whether the current token is the operator C.
+  bool
+  is_operator(int c) const
+  {
+    return (this->token_->classification() == Token::TOKEN_OPERATOR
+	    && this->token_->operator_value() == c);
+  }
+
+  // Return whether the current token is the keyword PARSECODE.
+  bool
+  is_keyword(int parsecode) const
+  { return this->parsecode_ == parsecode; }
+
+  // Return whether the current token is a string in the grammar: a
+  // STRING which is not a keyword, or a QUOTED_STRING.
+  bool
+  is_string() const
+  {
+    return ((this->token_->classification() == Token::TOKEN_STRING
+	     && this->parsecode_ == 0)
+	    || this->token_->classification() == Token::TOKEN_QUOTED_STRING);
+  }
+
+  bool
+  parse_patterns(Patterns*);
+
+  bool
+  parse_version_node();
+
+  bool
+  parse_dynamic_list_node();
+
+  // The lexer.
+  Lex lex_;
+  // Whether we are parsing a dynamic list rather than a version script.
+  bool is_dynamic_list_;
+  // The keywords for this kind of script.
+  const Keyword_to_parsecode* keywords_;
+  // The version nodes we have parsed.
+  std::vector<Node> nodes_;
+  // The current token.
+  const Token* token_;
+  // If the current token is a keyword, its parse code, otherwise 0.
+  int parsecode_;
+};
+
+// Read the next token.
+
+void
+Symbol_list_parser::next_token()
+{
+  this->token_ = this->lex_.next_token();
+  this->parsecode_ = 0;
+  if (this->token_->classification() == Token::TOKEN_STRING)
+    {
+      size_t len;
+      const char* str = this->token_->string_value(&len);
+      this->parsecode_ = this->keywords_->keyword_to_parsecode(str, len);
+    }
+}
+
+// Parse a list of patterns separated by semicolons, up to and
+// including the final semicolon.  This is the vers_defns rule without
+// extern blocks.  The current token is the first pattern.
+
+bool
+Symbol_list_parser::parse_patterns(Patterns* patterns)
+{
+  while (true)
+    {
+      if (!this->is_string())
+	return false;
+      size_t len;
+      const char* value = this->token_->string_value(&len);
+      patterns->push_back(Pattern(value, len,
+				  (this->token_->classification()
+				   == Token::TOKEN_QUOTED_STRING)));
+
+      this->next_token();
+      if (!this->is_operator(';'))
+	return false;
+      this->next_token();
+
+      // The list ends at a '}' or, in a version script, at "local:".
+      if (this->is_operator('}') || this->is_keyword(LOCAL))
+	return true;
+    }
+}
+
+// Parse a version node, following the vers_node rule.  The current
+// token is the first token of the node.
+
+bool
+Symbol_list_parser::parse_version_node()
+{
+  this->nodes_.push_back(Node());
+  Node& node(this->nodes_.back());
+  if (this->is_string())
+    {
+      node.tag = this->token_->string_value(&node.taglen);
+      this->next_token();
+    }
+
+  if (!this->is_operator('{'))
+    return false;
+  this->next_token();
+
+  if (this->is_keyword(GLOBAL))
+    {
+      this->next_token();
+      if (!this->is_operator(':'))
+	return false;
+      this->next_token();
+      if (!this->parse_patterns(&node.global))
+	return false;
+    }
+  else if (!this->is_operator('}') && !this->is_keyword(LOCAL))
+    {
+      if (!this->parse_patterns(&node.global))
+	return false;
+      // "local:" must be preceded by "global:".
+      if (this->is_keyword(LOCAL))
+	return false;
+    }
+
+  if (this->is_keyword(LOCAL))
+    {
+      this->next_token();
+      if (!this->is_operator(':'))
+	return false;
+      this->next_token();
+      if (!this->parse_patterns(&node.local))
+	return false;
+    }
+
+  if (!this->is_operator('}'))
+    return false;
+  this->next_token();
+
+  // Dependencies are only permitted after a tag.
+  while (node.tag != NULL && this->is_string())
+    {
+      size_t len;
+      const char* dep = this->token_->string_value(&len);
+      node.deps.push_back(std::make_pair(dep, len));
+      this->next_token();
+    }
+
+  if (!this->is_operator(';'))
+    return false;
+  this->next_token();
+  return true;
+}
+
+// Parse a dynamic list node, following the dynamic_list_node rule.
+// The current token is the first token of the node.
+
+bool
+Symbol_list_parser::parse_dynamic_list_node()
+{
+  this->nodes_.push_back(Node());
+  Node& node(this->nodes_.back());
+  if (!this->is_operator('{'))
+    return false;
+  this->next_token();
+  if (!this->parse_patterns(&node.local))
+    return false;
+  if (!this->is_operator('}'))
+    return false;
+  this->next_token();
+  if (!this->is_operator(';'))
+    return false;
+  this->next_token();
+  return true;
+}
+
+// Parse the whole input.
+
+bool
+Symbol_list_parser::parse()
+{
+  this->next_token();
+  if (this->token_->is_eof())
+    return false;
+  while (!this->token_->is_eof())
+    {
+      if (this->is_dynamic_list_)
+	{
+	  if (!this->parse_dynamic_list_node())
+	    return false;
+	}
+      else
+	{
+	  if (!this->parse_version_node())
+	    return false;
+	}
+    }
+  return true;
+}
+
+// Record the nodes in VSI, building the same structures as the bison
+// parser does.  This is defined here because it needs the complete
+// version script structs.
+
+void
+Symbol_list_parser::record(Version_script_info* vsi) const
+{
+  for (std::vector<Node>::const_iterator p = this->nodes_.begin();
+       p != this->nodes_.end();
+       ++p)
+    {
+      Version_tree* tree = vsi->allocate_version_tree();
+      const Patterns* lists[2] = { &p->global, &p->local };
+      const Version_expression_list** trees[2] = { &tree->global,
+						   &tree->local };
+      for (int i = 0; i < 2; ++i)
+	{
+	  if (lists[i]->empty())
+	    continue;
+	  Version_expression_list* explist = vsi->allocate_expression_list();
+	  explist->expressions.reserve(lists[i]->size());
+	  for (Patterns::const_iterator q = lists[i]->begin();
+	       q != lists[i]->end();
+	       ++q)
+	    explist->expressions.push_back(
+		Version_expression(std::string(q->value, q->length),
+				   Version_script_info::LANGUAGE_C,
+				   q->exact_match));
+	  *trees[i] = explist;
+	}
+
+      if (this->is_dynamic_list_)
+	continue;
+
+      if (!p->deps.empty())
+	{
+	  Version_dependency_list* deps = vsi->allocate_dependency_list();
+	  for (size_t i = 0; i < p->deps.size(); ++i)
+	    deps->dependencies.push_back(std::string(p->deps[i].first,
+						     p->deps[i].second));
+	  tree->dependencies = deps;
+	}
+      if (p->tag != NULL)
+	tree->tag = std::string(p->tag, p->taglen);
+    }
+}
+
+// Parse INPUT as a version script or dynamic list which is a plain
+// list of symbols, and store the result in VSI.  Return false, having
+// stored nothing, if INPUT needs the general parser.
+
+bool
+read_plain_symbol_list(const char* input, size_t length,
+		       bool is_dynamic_list, Version_script_info* vsi)
+{
+  Symbol_list_parser slp(input, length, is_dynamic_list);
+  if (!slp.parse())
+    return false;
+  slp.record(vsi);
+  return true;
+}
+
 // Helper class that calls cplus_demangle when needed and takes care of freeing
-// the result.
+// the result.  C++ demangling goes through the shared cache.
 
 class Lazy_demangler
 {
  public:
   Lazy_demangler(const char* symbol, int options)
-    : symbol_(symbol), options_(options), demangled_(NULL), did_demangle_(false)
+    : symbol_(symbol), options_(options), demangled_(NULL),
+      did_demangle_(false), use_cache_(options == (DMGL_ANSI | DMGL_PARAMS))
   { }
 
   ~Lazy_demangler()
-  { free(this->demangled_); }
+  {
+    if (!this->use_cache_)
+      free(const_cast<char*>(this->demangled_));
+  }
 
   // Return the demangled name. The actual demangling happens on the first call,
   // and the result is later cached.
-  inline char*
+  inline const char*
   get();
 
  private:
@@ -1962,26 +2328,48 @@ class Lazy_demangler
   const int options_;
   // The cached demangled value, or NULL if demangling didn't happen yet or
   // failed.
-  char* demangled_;
+  const char* demangled_;
   // Whether we already called cplus_demangle
   bool did_demangle_;
+  // Whether to use cplus_demangle_cached.
+  const bool use_cache_;
+  // The demangled name, when using cplus_demangle_cached.
+  std::string cached_;
 };
 
 // Return the demangled name. The actual demangling happens on the first call,
 // and the result is later cached. Returns NULL if the symbol cannot be
 // demangled.
 
-inline char*
+inline const char*
 Lazy_demangler::get()
 {
   if (!this->did_demangle_)
     {
-      this->demangled_ = cplus_demangle(this->symbol_, this->options_);
+      if (this->use_cache_)
+	{
+	  if (cplus_demangle_cached(this->symbol_, &this->cached_))
+	    this->demangled_ = this->cached_.c_str();
+	}
+      else
+	this->demangled_ = cplus_demangle(this->symbol_, this->options_);
       this->did_demangle_ = true;
     }
   return this->demangled_;
 }
 
+// Class Version_script_info::Glob.
+
+Version_script_info::Glob::Glob(const Version_expression* e,
+				const Version_tree* v, bool ig)
+  : expression(e), version(v), is_global(ig), prefix_length(0),
+    matches_any_suffix(false)
+{
+  const char* pattern = e->pattern.c_str();
+  this->prefix_length = strcspn(pattern, "?*[");
+  this->matches_any_suffix = strcmp(pattern + this->prefix_length, "*") == 0;
+}
+
 // Class Version_script_info.
 
 Version_script_info::Version_script_info()
@@ -1989,11 +2377,16 @@ Version_script_info::Version_script_info()
     default_version_(NULL), default_is_global_(false), is_finalized_(false)
 {
   for (int i = 0; i < LANGUAGE_COUNT; ++i)
-    this->exact_[i] = NULL;
+    {
+      this->exact_[i] = NULL;
+      this->glob_tries_[i] = NULL;
+    }
 }
 
 Version_script_info::~Version_script_info()
 {
+  for (int i = 0; i < LANGUAGE_COUNT; ++i)
+    delete this->glob_tries_[i];
 }
 
 // Forget all the known version script information.
@@ -2145,6 +2538,54 @@ Version_script_info::build_lookup_tables()
       this->build_expression_list_lookup(v->local, v, false);
       this->build_expression_list_lookup(v->global, v, true);
     }
+  this->build_glob_tries();
+}
+
+// Build a trie for each language from the literal prefixes of the
+// glob patterns.  Every pattern is stored at the node for its literal
+// prefix, so a walk along a symbol name visits exactly the patterns
+// whose prefix matches the name.
+
+void
+Version_script_info::build_glob_tries()
+{
+  for (unsigned int i = 0; i < this->globs_.size(); ++i)
+    {
+      const Glob& g(this->globs_[i]);
+      int language = g.expression->language;
+      Glob_trie* trie = this->glob_tries_[language];
+      if (trie == NULL)
+	{
+	  trie = new Glob_trie(1);
+	  this->glob_tries_[language] = trie;
+	}
+
+      const char* pattern = g.expression->pattern.c_str();
+      unsigned int node = 0;
+      for (size_t j = 0; j < g.prefix_length; ++j)
+	{
+	  std::pair<unsigned char, unsigned int> key(pattern[j], 0);
+	  std::vector<std::pair<unsigned char, unsigned int> >&
+	    children((*trie)[node].children);
+	  std::vector<std::pair<unsigned char, unsigned int> >::iterator p =
+	    std::lower_bound(children.begin(), children.end(), key);
+	  if (p != children.end() && p->first == key.first)
+	    node = p->second;
+	  else
+	    {
+	      unsigned int child = trie->size();
+	      key.second = child;
+	      children.insert(p, key);
+	      // This may reallocate the trie, so CHILDREN is not used
+	      // after this point.
+	      trie->push_back(Glob_trie_node());
+	      node = child;
+	    }
+	}
+
+      // We walk globs_ in order, so this vector stays sorted.
+      (*trie)[node].globs.push_back(i);
+    }
 }
 
 // If a pattern has backlashes but no unquoted wildcard characters,
@@ -2295,6 +2736,62 @@ Version_script_info::get_name_to_match(const char* name,
     }
 }
 
+// Return whether the glob pattern G matches NAME.  The caller has
+// already checked that NAME starts with the literal prefix of G.
+
+bool
+Version_script_info::glob_matches(const Glob& g, const char* name) const
+{
+  if (g.matches_any_suffix)
+    return true;
+  return fnmatch(g.expression->pattern.c_str() + g.prefix_length,
+		 name + g.prefix_length, FNM_NOESCAPE) == 0;
+}
+
+// Walk TRIE along NAME, looking for the last pattern in globs_ that
+// matches NAME.  If FOUND is true, only patterns after *PINDEX are
+// of interest.  Return true and set *PINDEX if a pattern is found.
+
+bool
+Version_script_info::match_glob_trie(const Glob_trie* trie, const char* name,
+				     bool found, unsigned int* pindex) const
+{
+  const Glob_trie_node* node = &(*trie)[0];
+  const char* p = name;
+  bool ret = false;
+  while (true)
+    {
+      // Try the patterns at this node from last to first, so that we
+      // can stop at the first match.
+      for (std::vector<unsigned int>::const_reverse_iterator pg =
+	     node->globs.rbegin();
+	   pg != node->globs.rend();
+	   ++pg)
+	{
+	  if ((found || ret) && *pg <= *pindex)
+	    break;
+	  if (this->glob_matches(this->globs_[*pg], name))
+	    {
+	      *pindex = *pg;
+	      ret = true;
+	      break;
+	    }
+	}
+
+      if (*p == '\0' || node->children.empty())
+	break;
+
+      std::pair<unsigned char, unsigned int> key(*p, 0);
+      std::vector<std::pair<unsigned char, unsigned int> >::const_iterator pc =
+	std::lower_bound(node->children.begin(), node->children.end(), key);
+      if (pc == node->children.end() || pc->first != key.first)
+	break;
+      node = &(*trie)[pc->second];
+      ++p;
+    }
+  return ret;
+}
+
 // Look up SYMBOL_NAME in the list of versions.  Return true if the
 // symbol is found, false if not.  If the symbol is found, then if
 // PVERSION is not NULL, set *PVERSION to the version tag, and if
@@ -2356,29 +2853,36 @@ Version_script_info::get_symbol_version(const char* symbol_name,
 	}
     }
 
-  // Look through the glob patterns in reverse order.
+  // Look through the glob patterns.  The last pattern in the script
+  // which matches wins.  We only demangle the name for a language if
+  // there are patterns for that language.
 
-  for (Globs::const_reverse_iterator p = this->globs_.rbegin();
-       p != this->globs_.rend();
-       ++p)
+  bool found = false;
+  unsigned int glob_index = 0;
+  for (int i = 0; i < LANGUAGE_COUNT; ++i)
     {
-      int language = p->expression->language;
-      const char* name_to_match = this->get_name_to_match(symbol_name,
-							  language,
+      const Glob_trie* trie = this->glob_tries_[i];
+      if (trie == NULL)
+	continue;
+
+      const char* name_to_match = this->get_name_to_match(symbol_name, i,
 							  &cpp_demangled_name,
 							  &java_demangled_name);
       if (name_to_match == NULL)
 	continue;
 
-      if (fnmatch(p->expression->pattern.c_str(), name_to_match,
-		  FNM_NOESCAPE) == 0)
-	{
-	  if (pversion != NULL)
-	    *pversion = p->version->tag;
-	  if (p_is_global != NULL)
-	    *p_is_global = p->is_global;
-	  return true;
-	}
+      if (this->match_glob_trie(trie, name_to_match, found, &glob_index))
+	found = true;
+    }
+
+  if (found)
+    {
+      const Glob& g(this->globs_[glob_index]);
+      if (pversion != NULL)
+	*pversion = g.version->tag;
+      if (p_is_global != NULL)
+	*p_is_global = g.is_global;
+      return true;
     }
 
   // Finally, there may be a wildcard.
@@ -268,12 +268,11 @@ class Version_script_info
   struct Glob
   {
     Glob()
-      : expression(NULL), version(NULL), is_global(false)
+      : expression(NULL), version(NULL), is_global(false),
+	prefix_length(0), matches_any_suffix(false)
     { }
 
-    Glob(const Version_expression* e, const Version_tree* v, bool ig)
-      : expression(e), version(v), is_global(ig)
-    { }
+    Glob(const Version_expression* e, const Version_tree* v, bool ig);
 
     // A pointer to the version expression holding the pattern to
     // match and the language to use for demangling the symbol before
@@ -283,10 +282,36 @@ class Version_script_info
     const Version_tree* version;
     // True if this is a global symbol.
     bool is_global;
+    // The length of the literal prefix of the pattern, which is the
+    // part before the first wildcard character.
+    size_t prefix_length;
+    // True if the rest of the pattern after the literal prefix is
+    // just "*", so that any name with the prefix matches.
+    bool matches_any_suffix;
   };
 
   typedef std::vector<Glob> Globs;
 
+  // A node in a trie of the literal prefixes of the glob patterns
+  // for a single language.  This lets us find the patterns which can
+  // possibly match a name in a single walk over the name.
+  struct Glob_trie_node
+  {
+    Glob_trie_node()
+      : children(), globs()
+    { }
+
+    // The children of this node, sorted by character.  The second
+    // element is the index of the child in the trie.
+    std::vector<std::pair<unsigned char, unsigned int> > children;
+    // The indexes in globs_ of the patterns whose literal prefix ends
+    // at this node, in increasing order.
+    std::vector<unsigned int> globs;
+  };
+
+  // A trie is stored as a vector of nodes; the root is element zero.
+  typedef std::vector<Glob_trie_node> Glob_trie;
+
   bool
   unquote(std::string*) const;
 
@@ -298,6 +323,15 @@ class Version_script_info
   build_expression_list_lookup(const Version_expression_list*,
 			       const Version_tree*, bool);
 
+  void
+  build_glob_tries();
+
+  bool
+  glob_matches(const Glob&, const char*) const;
+
+  bool
+  match_glob_trie(const Glob_trie*, const char*, bool, unsigned int*) const;
+
   const char*
   get_name_to_match(const char*, int,
 		    Lazy_demangler*, Lazy_demangler*) const;
@@ -312,6 +346,8 @@ class Version_script_info
   Exact* exact_[LANGUAGE_COUNT];
   // A vector of glob patterns mapping to Version_trees.
   Globs globs_;
+  // Tries indexing globs_ by literal prefix, by language.
+  Glob_trie* glob_tries_[LANGUAGE_COUNT];
   // The default version to use, if there is one.  This is from a
   // pattern of "*".
   const Version_tree* default_version_;
@@ -591,6 +627,24 @@ bool
 read_dynamic_list(const char* filename, Command_line* cmdline,
                   Script_options* dynamic_list);
 
+// INPUT, of LENGTH bytes and null terminated, is the contents of a
+// version script or, if IS_DYNAMIC_LIST, a dynamic list.  If it is a
+// plain list of symbols, parse it without the general parser, store
+// its contents in VSI and return true.  Otherwise return false without
+// changing VSI.
+
+bool
+read_plain_symbol_list(const char* input, size_t length,
+		       bool is_dynamic_list, Version_script_info* vsi);
+
+// Parse INPUT, as above, with the general parser, and store its
+// contents in SCRIPT_OPTIONS.  Return false on a syntax error.
+
+bool
+read_symbol_list_script(const char* filename, const char* input,
+			size_t length, bool is_dynamic_list,
+			Script_options* script_options);
+
 } // End namespace gold.
 
 #endif // !defined(GOLD_SCRIPT_H)
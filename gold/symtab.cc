@@ -91,15 +91,11 @@ demangle(const char* name)
   if (!parameters->options().do_demangle())
     return name;
 
-  // cplus_demangle allocates memory for the result it returns,
-  // and returns NULL if the name is already demangled.
-  char* demangled_name = cplus_demangle(name, DMGL_ANSI | DMGL_PARAMS);
-  if (demangled_name == NULL)
+  // This returns false if the name is already demangled.
+  std::string demangled_name;
+  if (!cplus_demangle_cached(name, &demangled_name))
     return name;
-
-  std::string retval(demangled_name);
-  free(demangled_name);
-  return retval;
+  return demangled_name;
 }
 
 std::string
@@ -394,28 +390,23 @@ Symbol::should_add_dynsym_entry(Symbol_table* symtab) const
     {
       // TODO(csilvers): We could probably figure out if we're an operator
       //                 new/delete or typeinfo without the need to demangle.
-      char* demangled_name = cplus_demangle(this->name(),
-                                            DMGL_ANSI | DMGL_PARAMS);
-      if (demangled_name == NULL)
+      std::string demangled;
+      if (!cplus_demangle_cached(this->name(), &demangled))
         {
           // Not a C++ symbol, so it can't satisfy these flags
         }
-      else if (parameters->options().dynamic_list_cpp_new()
-               && (strprefix(demangled_name, "operator new")
-                   || strprefix(demangled_name, "operator delete")))
-        {
-          free(demangled_name);
-          return true;
-        }
-      else if (parameters->options().dynamic_list_cpp_typeinfo()
-               && (strprefix(demangled_name, "typeinfo name for")
-                   || strprefix(demangled_name, "typeinfo for")))
+      else
         {
-          free(demangled_name);
-          return true;
+          const char* demangled_name = demangled.c_str();
+          if (parameters->options().dynamic_list_cpp_new()
+              && (strprefix(demangled_name, "operator new")
+                  || strprefix(demangled_name, "operator delete")))
+            return true;
+          else if (parameters->options().dynamic_list_cpp_typeinfo()
+                   && (strprefix(demangled_name, "typeinfo name for")
+                       || strprefix(demangled_name, "typeinfo for")))
+            return true;
         }
-      else
-        free(demangled_name);
     }
 
   // If exporting all symbols or building a shared library,
@@ -1195,32 +1186,38 @@ Symbol_table::add_from_relobj(
 	    }
 	  ver = this->namepool_.add(ver, true, &ver_key);
         }
+      else
+	namelen = strlen(name);
+
+      // Canonicalize NAME before we look it up in the version script;
+      // the demangler cache is keyed on the address of the pooled name.
+      Stringpool::Key name_key;
+      name = this->namepool_.add_with_length(name, namelen, true,
+					     &name_key);
+
       // We don't want to assign a version to an undefined symbol,
       // even if it is listed in the version script.  FIXME: What
       // about a common symbol?
-      else
+      if (ver == NULL
+	  && !this->version_script_.empty()
+	  && st_shndx != elfcpp::SHN_UNDEF)
 	{
-	  namelen = strlen(name);
-	  if (!this->version_script_.empty()
-	      && st_shndx != elfcpp::SHN_UNDEF)
+	  // The symbol name did not have a version, but the
+	  // version script may assign a version anyway.
+	  std::string version;
+	  bool is_global;
+	  if (this->version_script_.get_symbol_version(name, &version,
+						       &is_global))
 	    {
-	      // The symbol name did not have a version, but the
-	      // version script may assign a version anyway.
-	      std::string version;
-	      bool is_global;
-	      if (this->version_script_.get_symbol_version(name, &version,
-							   &is_global))
+	      if (!is_global)
+		is_forced_local = true;
+	      else if (!version.empty())
 		{
-		  if (!is_global)
-		    is_forced_local = true;
-		  else if (!version.empty())
-		    {
-		      ver = this->namepool_.add_with_length(version.c_str(),
-							    version.length(),
-							    true,
-							    &ver_key);
-		      is_default_version = true;
-		    }
+		  ver = this->namepool_.add_with_length(version.c_str(),
+							version.length(),
+							true,
+							&ver_key);
+		  is_default_version = true;
 		}
 	    }
 	}
@@ -1271,10 +1268,6 @@ Symbol_table::add_from_relobj(
 	    }
         }
 
-      Stringpool::Key name_key;
-      name = this->namepool_.add_with_length(name, namelen, true,
-					     &name_key);
-
       Sized_symbol<size>* res;
       res = this->add_from_object(relobj, name, name_key, ver, ver_key,
 				  is_default_version, *psym, st_shndx,
@@ -1319,6 +1312,10 @@ Symbol_table::add_from_pluginobj(
   bool is_default_version = false;
   bool is_forced_local = false;
 
+  // Canonicalize NAME first, as in add_from_relobj.
+  Stringpool::Key name_key;
+  name = this->namepool_.add(name, true, &name_key);
+
   if (ver != NULL)
     {
       ver = this->namepool_.add(ver, true, &ver_key);
@@ -1352,9 +1349,6 @@ Symbol_table::add_from_pluginobj(
         }
     }
 
-  Stringpool::Key name_key;
-  name = this->namepool_.add(name, true, &name_key);
-
   Sized_symbol<size>* res;
   res = this->add_from_object(obj, name, name_key, ver, ver_key,
 		              is_default_version, *sym, st_shndx,
@@ -1699,6 +1693,20 @@ Symbol_table::define_special_symbol(const char** pname, const char** pversion,
   *resolve_oldsym = false;
   *poldsym = NULL;
 
+  // Canonicalize NAME before we look it up in the version script;
+  // the demangler cache is keyed on the address of the pooled name.
+  // If we only define the symbol when it is referenced, and the name
+  // is not in the pool, then there is no reference.
+  Stringpool::Key name_key;
+  if (!only_if_ref)
+    *pname = this->namepool_.add(*pname, true, &name_key);
+  else
+    {
+      *pname = this->namepool_.find(*pname, &name_key);
+      if (*pname == NULL)
+	return NULL;
+    }
+
   // If the caller didn't give us a version, see if we get one from
   // the version script.
   std::string v;
@@ -1742,10 +1750,7 @@ Symbol_table::define_special_symbol(const char** pname, const char** pversion,
     }
   else
     {
-      // Canonicalize NAME and VERSION.
-      Stringpool::Key name_key;
-      *pname = this->namepool_.add(*pname, true, &name_key);
-
+      // Canonicalize VERSION.
       Stringpool::Key version_key = 0;
       if (*pversion != NULL)
 	*pversion = this->namepool_.add(*pversion, true, &version_key);
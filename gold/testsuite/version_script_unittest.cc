@@ -0,0 +1,175 @@
+// version_script_unittest.cc -- test the fast version script parser
+
+// Copyright (C) 2014 Free Software Foundation, Inc.
+
+// This file is part of gold.
+
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street - Fifth Floor, Boston,
+// MA 02110-1301, USA.
+
+#include "gold.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "errors.h"
+#include "options.h"
+#include "parameters.h"
+#include "script.h"
+
+#include "test.h"
+
+namespace gold_testsuite
+{
+
+using namespace gold;
+
+// Scripts which read_plain_symbol_list should accept.
+
+static const char* const plain_version_scripts[] =
+{
+  "VERS_1 { global: foo; bar*; local: *; };",
+  "VERS_1 { foo; bar; };\nVERS_2 { global: baz; } VERS_1;",
+  "{ global: foo; local: *; };",
+  "VERS_1 { };\nVERS_2 { local: hidden_*; } VERS_1;",
+  "/* comment */ VERS_1 {\n  global:\n    \"quoted name\";\n"
+  "    foo::bar;\n    x[abc]?;\n  local:\n    *;\n};\n",
+  "\"VERS 1\" { global: foo; };",
+  "VERS_3 { global: a; } VERS_1 VERS_2;",
+  "V1{global:a;b;local:*;};V2{c;}V1;",
+  "VERS_1 { global: C; Java; };",
+};
+
+static const char* const plain_dynamic_lists[] =
+{
+  "{ foo; bar*; };",
+  "{ foo; };\n{ \"bar\"; baz; };",
+  "/* comment */ { global; local; };",
+};
+
+// Scripts which need the general parser, either because they use
+// features the fast path does not handle or because they are
+// erroneous.
+
+static const char* const other_version_scripts[] =
+{
+  "VERS_1 { global: extern \"C++\" { foo::bar; }; local: *; };",
+  "VERS_1 { global: foo; extern \"C\" { bar; }; };",
+  "VERS_1 { foo; local: *; };",
+  "VERS_1 { global: global; };",
+  "VERS_1 { global: foo };",
+  "VERS_1 { global: foo; }",
+  "{ foo; } VERS_1;",
+  "VERS_1 { global: foo; } extern;",
+  "VERS_1 global: foo; };",
+  "",
+  "  /* only a comment */ ",
+  "VERS_1 { global: foo; ; };",
+};
+
+static const char* const other_dynamic_lists[] =
+{
+  "{ extern \"C++\" { foo::bar; }; };",
+  "{ foo };",
+  "{ foo; }",
+  "foo;",
+  "{ extern; };",
+  "",
+};
+
+// Parse INPUT with the general parser and with the fast parser.
+// Check that they agree on whether the input is valid and, if so, that
+// they produce the same version script information.  Return whether
+// the fast parser accepted the input.
+
+static bool
+compare_parsers(const char* input, bool is_dynamic_list)
+{
+  size_t length = strlen(input);
+
+  Script_options general;
+  bool general_ok = read_symbol_list_script("test", input, length,
+					    is_dynamic_list, &general);
+
+  Script_options fast;
+  bool fast_ok = read_plain_symbol_list(input, length, is_dynamic_list,
+					fast.version_script_info());
+
+  // The fast parser must never accept something the general parser
+  // rejects.
+  CHECK(general_ok || !fast_ok);
+  if (!fast_ok)
+    {
+      CHECK(fast.version_script_info()->empty());
+      return false;
+    }
+
+  std::string texts[2];
+  const Version_script_info* infos[2] = { general.version_script_info(),
+					  fast.version_script_info() };
+  for (int i = 0; i < 2; ++i)
+    {
+      FILE* f = tmpfile();
+      CHECK(f != NULL);
+      infos[i]->print(f);
+      rewind(f);
+      char buf[256];
+      size_t n;
+      while ((n = fread(buf, 1, sizeof buf, f)) > 0)
+	texts[i].append(buf, n);
+      fclose(f);
+    }
+  CHECK(texts[0] == texts[1]);
+
+  return true;
+}
+
+bool
+Version_script_test(Test_report*)
+{
+  Errors errors(gold::program_name);
+  set_parameters_errors(&errors);
+
+  General_options options;
+  set_parameters_options(&options);
+
+  for (size_t i = 0;
+       i < sizeof plain_version_scripts / sizeof plain_version_scripts[0];
+       ++i)
+    CHECK(compare_parsers(plain_version_scripts[i], false));
+
+  for (size_t i = 0;
+       i < sizeof plain_dynamic_lists / sizeof plain_dynamic_lists[0];
+       ++i)
+    CHECK(compare_parsers(plain_dynamic_lists[i], true));
+
+  for (size_t i = 0;
+       i < sizeof other_version_scripts / sizeof other_version_scripts[0];
+       ++i)
+    CHECK(!compare_parsers(other_version_scripts[i], false));
+
+  for (size_t i = 0;
+       i < sizeof other_dynamic_lists / sizeof other_dynamic_lists[0];
+       ++i)
+    CHECK(!compare_parsers(other_dynamic_lists[i], true));
+
+  return true;
+}
+
+Register_test version_script_register("Version_script",
+				      Version_script_test);
+
+} // End namespace gold_testsuite.
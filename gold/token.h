@@ -86,7 +86,10 @@ class Task_list
 
 // These tokens are only manipulated when the workqueue lock is held
 // or when they are first created.  They do not require any locking
-// themselves.
+// themselves.  The one exception is the blocker count, which is
+// updated atomically when the compiler supports it, so that a task
+// which already holds a blocker may add another one without taking
+// the workqueue lock.
 
 class Task_token
 {
@@ -138,19 +141,18 @@ class Task_token
   // Add a blocker to the token.
   void
   add_blocker()
-  {
-    gold_assert(this->is_blocker_);
-    ++this->blockers_;
-    this->writer_ = NULL;
-  }
+  { this->add_blockers(1); }
 
   // Add some number of blockers to the token.
   void
   add_blockers(int c)
   {
     gold_assert(this->is_blocker_);
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+    __sync_add_and_fetch(&this->blockers_, c);
+#else
     this->blockers_ += c;
-    this->writer_ = NULL;
+#endif
   }
 
   // Remove a blocker from the token.  Returns true if block count
@@ -159,9 +161,12 @@ class Task_token
   remove_blocker()
   {
     gold_assert(this->is_blocker_ && this->blockers_ > 0);
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+    return __sync_sub_and_fetch(&this->blockers_, 1) == 0;
+#else
     --this->blockers_;
-    this->writer_ = NULL;
     return this->blockers_ == 0;
+#endif
   }
 
   // Is the token currently blocked?
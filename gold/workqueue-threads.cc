@@ -130,7 +130,7 @@ Workqueue_threader_threadpool::Workqueue_threader_threadpool(
     Workqueue* workqueue)
   : Workqueue_threader(workqueue),
     check_thread_count_(0),
-    lock_(),
+    lock_("threadpool"),
     desired_thread_count_(1),
     threads_(1)
 {
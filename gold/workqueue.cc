@@ -22,8 +22,19 @@
 
 #include "gold.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <unistd.h>
+#include <sys/time.h>
+
+#ifdef HAVE_GETRUSAGE
+#include <sys/resource.h>
+#endif
+
 #include "debug.h"
 #include "options.h"
+#include "parameters.h"
 #include "timer.h"
 #include "workqueue.h"
 #include "workqueue-internal.h"
@@ -31,6 +42,43 @@
 namespace gold
 {
 
+// Return the current wall clock time in microseconds, preferably from
+// a clock which is not affected by changes to the system time.
+
+static uint64_t
+wall_time_usec()
+{
+#if defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000
+	    + static_cast<uint64_t>(ts.tv_nsec) / 1000);
+#endif
+#ifdef HAVE_GETTIMEOFDAY
+  struct timeval tv;
+  if (gettimeofday(&tv, NULL) == 0)
+    return (static_cast<uint64_t>(tv.tv_sec) * 1000000
+	    + static_cast<uint64_t>(tv.tv_usec));
+#endif
+  return 0;
+}
+
+// Return the user and system CPU time used by all the threads of the
+// process, in microseconds, or 0 if we can't tell.
+
+static uint64_t
+cpu_time_usec()
+{
+#ifdef HAVE_GETRUSAGE
+  struct rusage ru;
+  if (getrusage(RUSAGE_SELF, &ru) == 0)
+    return (static_cast<uint64_t>(ru.ru_utime.tv_sec
+				  + ru.ru_stime.tv_sec) * 1000000
+	    + static_cast<uint64_t>(ru.ru_utime.tv_usec + ru.ru_stime.tv_usec));
+#endif
+  return 0;
+}
+
 // Class Task_list.
 
 // Add T to the end of the list.
@@ -117,12 +165,18 @@ class Workqueue_threader_single : public Workqueue_threader
 // Workqueue methods.
 
 Workqueue::Workqueue(const General_options& options)
-  : lock_(),
+  : cpu_count_(Workqueue::init_cpu_count()),
+    lock_("workqueue"),
     first_tasks_(),
     tasks_(),
     running_(0),
     waiting_(0),
     condvar_(this->lock_),
+    thread_count_(1),
+    adaptive_max_(0),
+    task_wall_time_(0),
+    phase_cpu_start_(0),
+    adaptive_phases_(),
     threader_(NULL)
 {
   bool threads = options.threads();
@@ -145,6 +199,23 @@ Workqueue::~Workqueue()
 {
 }
 
+// Return the number of online CPUs.  The workqueue is created before
+// any threads are started, so this is also where the Lock class
+// learns the CPU count.
+
+int
+Workqueue::init_cpu_count()
+{
+  int cpu_count = 1;
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus > 0)
+    cpu_count = static_cast<int>(cpus);
+#endif
+  Lock::set_cpu_count(cpu_count);
+  return cpu_count;
+}
+
 // Add a task to the end of a specific queue, or put it on the list
 // waiting for a Token.
 
@@ -170,6 +241,7 @@ Workqueue::add_to_queue(Task_list* queue, Task* t, bool front)
 	queue->push_back(t);
       // Tell any waiting thread that there is work to do.
       this->condvar_.signal();
+      this->maybe_add_thread();
     }
 }
 
@@ -290,6 +362,9 @@ Workqueue::find_and_run_task(int thread_number)
 {
   Task* t;
   Task_locker tl;
+  // Whether we are choosing the thread count automatically, and so
+  // need to time the tasks.  This is read with the lock held.
+  bool adaptive;
 
   {
     Hold_lock hl(this->lock_);
@@ -305,6 +380,7 @@ Workqueue::find_and_run_task(int thread_number)
     t->locks(&tl);
 
     ++this->running_;
+    adaptive = this->adaptive_max_ > 0;
   }
 
   while (t != NULL)
@@ -315,9 +391,12 @@ Workqueue::find_and_run_task(int thread_number)
       Timer timer;
       if (is_debugging_enabled(DEBUG_TASK))
         timer.start();
+      uint64_t start_usec = adaptive ? wall_time_usec() : 0;
 
       t->run(this);
 
+      uint64_t task_wall = adaptive ? wall_time_usec() - start_usec : 0;
+
       if (is_debugging_enabled(DEBUG_TASK))
         {
           Timer::TimeStats elapsed = timer.get_elapsed_time();
@@ -336,6 +415,10 @@ Workqueue::find_and_run_task(int thread_number)
 	Hold_lock hl(this->lock_);
 
 	--this->running_;
+	// The thread count may have been set explicitly while the task
+	// ran, in which case the time no longer matters.
+	if (this->adaptive_max_ > 0)
+	  this->task_wall_time_ += task_wall;
 
 	// Release the locks for the task.  This must be done with the
 	// workqueue lock held.  Get the next Task to run if any.
@@ -353,6 +436,7 @@ Workqueue::find_and_run_task(int thread_number)
 
 	    ++this->running_;
 	  }
+	adaptive = this->adaptive_max_ > 0;
       }
 
       // We are done with this task.
@@ -432,6 +516,7 @@ Workqueue::return_or_queue(Task* t, bool is_blocker, Task** pret)
       else
 	this->tasks_.push_back(t);
       this->condvar_.signal();
+      this->maybe_add_thread();
       return false;
     }
 
@@ -504,18 +589,132 @@ Workqueue::set_thread_count(int threads)
 {
   Hold_lock hl(this->lock_);
 
+  this->adaptive_max_ = 0;
+  this->thread_count_ = threads;
   this->threader_->set_thread_count(threads);
   // Wake up all the threads, since something has changed.
   this->condvar_.broadcast();
 }
 
+// Choose the number of threads automatically.
+
+void
+Workqueue::set_adaptive_thread_count(int max_useful)
+{
+  // Without threads there is nothing to choose.
+  if (!parameters->options().threads())
+    {
+      this->set_thread_count(1);
+      return;
+    }
+
+  Hold_lock hl(this->lock_);
+
+  this->adaptive_max_ = std::max(max_useful, 1);
+  this->task_wall_time_ = 0;
+  this->phase_cpu_start_ = cpu_time_usec();
+  this->thread_count_ = std::min(this->cpu_count_, this->adaptive_max_);
+  this->adaptive_phases_.push_back(Adaptive_phase(this->adaptive_max_,
+						  this->thread_count_));
+
+  gold_debug(DEBUG_TASK, "adaptive thread count %d (max %d, %d cpus)",
+	     this->thread_count_, this->adaptive_max_, this->cpu_count_);
+
+  this->threader_->set_thread_count(this->thread_count_);
+  this->condvar_.broadcast();
+}
+
+// Return the largest number of threads to use when choosing the
+// thread count automatically.  If the tasks run so far have taken
+// more wall clock time than the process has used CPU time, they have
+// been waiting for I/O, and more threads than CPUs will help.  The
+// workqueue lock must be held when this is called.
+
+int
+Workqueue::adaptive_thread_limit()
+{
+  // Don't let the threads outnumber the CPUs by more than this
+  // factor, however long the tasks wait.
+  const uint64_t max_factor = 4;
+
+  // Don't go beyond one thread per CPU until the tasks in this phase
+  // have run for this many microseconds of wall clock time.  A few
+  // short tasks tell us nothing about how much they wait.
+  const uint64_t min_sample_usec = 50000;
+
+  uint64_t limit = this->cpu_count_;
+  uint64_t cpu = cpu_time_usec() - this->phase_cpu_start_;
+  if (this->task_wall_time_ >= min_sample_usec
+      && cpu > 0
+      && this->task_wall_time_ > cpu)
+    limit = std::min(this->task_wall_time_ * this->cpu_count_ / cpu,
+		     this->cpu_count_ * max_factor);
+  return static_cast<int>(std::min(limit,
+				   static_cast<uint64_t>(this->adaptive_max_)));
+}
+
+// When choosing the thread count automatically, add a thread if every
+// thread is busy while a runnable task is waiting.  The workqueue lock
+// must be held when this is called.
+
+void
+Workqueue::maybe_add_thread()
+{
+  if (this->adaptive_max_ == 0
+      || this->running_ < this->thread_count_
+      || this->thread_count_ >= this->adaptive_max_)
+    return;
+
+  if (this->thread_count_ >= this->adaptive_thread_limit())
+    return;
+
+  ++this->thread_count_;
+  gold_debug(DEBUG_TASK, "adding thread; thread count now %d",
+	     this->thread_count_);
+  this->threader_->set_thread_count(this->thread_count_);
+
+  Adaptive_phase& phase(this->adaptive_phases_.back());
+  ++phase.threads_added;
+  phase.max_threads = std::max(phase.max_threads, this->thread_count_);
+}
+
+// Print statistics about the thread counts chosen automatically.
+
+void
+Workqueue::print_stats()
+{
+  Hold_lock hl(this->lock_);
+
+  if (this->adaptive_phases_.empty())
+    return;
+
+  fprintf(stderr, _("%s: workqueue CPUs: %d\n"),
+	  program_name, this->cpu_count_);
+  for (size_t i = 0; i < this->adaptive_phases_.size(); ++i)
+    {
+      const Adaptive_phase& phase(this->adaptive_phases_[i]);
+      fprintf(stderr,
+	      _("%s: workqueue phase %u: threads started: %d "
+		"added: %d max: %d (useful: %d)\n"),
+	      program_name, static_cast<unsigned int>(i + 1),
+	      phase.initial_threads, phase.threads_added, phase.max_threads,
+	      phase.max_useful);
+    }
+}
+
 // Add a new blocker to an existing Task_token.
 
 void
 Workqueue::add_blocker(Task_token* token)
 {
+#ifdef __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4
+  // The count is updated atomically, and the caller holds a blocker
+  // on TOKEN, so it can not become unblocked while we do this.
+  token->add_blocker();
+#else
   Hold_lock hl(this->lock_);
   token->add_blocker();
+#endif
 }
 
 } // End namespace gold.
@@ -28,6 +28,7 @@
 #define GOLD_WORKQUEUE_H
 
 #include <string>
+#include <vector>
 
 #include "gold-threads.h"
 #include "token.h"
@@ -227,9 +228,29 @@ class Workqueue
   void
   set_thread_count(int);
 
-  // Add a new blocker to an existing Task_token. This must be done
-  // with the workqueue lock held.  This should not be done routinely,
-  // only in special circumstances.
+  // Choose the thread count automatically.  MAX_USEFUL is the largest
+  // number of tasks which can usefully run at once in the coming
+  // phase of the link.  We start with one thread per CPU, capped at
+  // MAX_USEFUL, and add threads while runnable tasks are waiting for
+  // one.  If the tasks spend much of their time waiting for I/O, we
+  // allow more threads than there are CPUs.  The thread count is
+  // reduced again by the next call to this function or to
+  // set_thread_count.
+  void
+  set_adaptive_thread_count(int max_useful);
+
+  // Return the number of CPUs available.
+  int
+  cpu_count() const
+  { return this->cpu_count_; }
+
+  // Print statistics about the thread counts chosen automatically.
+  void
+  print_stats();
+
+  // Add a new blocker to an existing Task_token.  The caller must
+  // itself hold a blocker on the token.  This should not be done
+  // routinely, only in special circumstances.
   void
   add_blocker(Task_token*);
 
@@ -270,6 +291,40 @@ class Workqueue
   bool
   should_cancel_thread(int thread_number);
 
+  // Add a thread if a runnable task is waiting for one.
+  void
+  maybe_add_thread();
+
+  // Return the current upper bound for the adaptive thread count.
+  int
+  adaptive_thread_limit();
+
+  // Record the thread counts chosen in one phase of the link, for
+  // --stats.
+  struct Adaptive_phase
+  {
+    Adaptive_phase(int m, int t)
+      : max_useful(m), initial_threads(t), max_threads(t), threads_added(0)
+    { }
+
+    // The largest useful thread count for the phase.
+    int max_useful;
+    // The number of threads we started with.
+    int initial_threads;
+    // The largest number of threads we used.
+    int max_threads;
+    // The number of times we added a thread.
+    int threads_added;
+  };
+
+  // Return the number of CPUs, and pass it on to the Lock class.
+  static int
+  init_cpu_count();
+
+  // The number of CPUs available.  This is set at construction time
+  // and not changed thereafter.  It is declared before lock_ so that
+  // the Lock class knows the CPU count before lock_ is created.
+  int cpu_count_;
   // Master Workqueue lock.  This controls access to the following
   // member variables.
   Lock lock_;
@@ -284,6 +339,20 @@ class Workqueue
   // Condition variable associated with lock_.  This is signalled when
   // there may be a new Task to execute.
   Condvar condvar_;
+  // The desired number of threads.
+  int thread_count_;
+  // If we are choosing the thread count automatically, the largest
+  // thread count which is useful in this phase.  Otherwise zero.
+  int adaptive_max_;
+  // When choosing the thread count automatically, the total wall
+  // clock time in microseconds of the tasks run in this phase, and
+  // the CPU time used by the process at the start of the phase.
+  // Comparing the task time with the CPU time used since tells us
+  // how much time tasks spend waiting rather than running.
+  uint64_t task_wall_time_;
+  uint64_t phase_cpu_start_;
+  // The thread counts chosen automatically in each phase.
+  std::vector<Adaptive_phase> adaptive_phases_;
 
   // The threading implementation.  This is set at construction time
   // and not changed thereafter.
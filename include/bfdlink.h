@@ -541,6 +541,13 @@ struct bfd_link_info
 
   /* The version information.  */
   struct bfd_elf_version_tree *version_info;
+
+  /* Statistics for ld --stats: the number of passes made over
+     archive maps when adding archive symbols, and the number of
+     archive map symbols looked up in the hash table in those
+     passes.  */
+  unsigned long archive_passes;
+  unsigned long archive_lookups;
 };
 
 /* This structures holds a set of callback functions.  These are called
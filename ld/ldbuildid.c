@@ -28,12 +28,184 @@
 #define streq(a,b)     strcmp ((a), (b)) == 0
 #define strneq(a,b,n)  strncmp ((a), (b), (n)) == 0
 
+#ifdef BFD_HOST_64_BIT
+/* The "fast" style uses the 64-bit xxHash algorithm, which is much
+   quicker than md5 or sha1 on large outputs but is not a
+   cryptographic hash.  */
+
+#define XXH_PRIME64_1 ((bfd_uint64_t) 0x9E3779B1 << 32 | 0x85EBCA87)
+#define XXH_PRIME64_2 ((bfd_uint64_t) 0xC2B2AE3D << 32 | 0x27D4EB4F)
+#define XXH_PRIME64_3 ((bfd_uint64_t) 0x165667B1 << 32 | 0x9E3779F9)
+#define XXH_PRIME64_4 ((bfd_uint64_t) 0x85EBCA77 << 32 | 0xC2B2AE63)
+#define XXH_PRIME64_5 ((bfd_uint64_t) 0x27D4EB2F << 32 | 0x165667C5)
+
+#define XXH_ROTL64(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+struct xxh64_ctx
+{
+  bfd_uint64_t v[4];
+  bfd_uint64_t total;
+  unsigned char buf[32];
+  size_t buflen;
+};
+
+static bfd_uint64_t
+xxh64_read64 (const unsigned char *p)
+{
+  return ((bfd_uint64_t) p[0]
+	  | (bfd_uint64_t) p[1] << 8
+	  | (bfd_uint64_t) p[2] << 16
+	  | (bfd_uint64_t) p[3] << 24
+	  | (bfd_uint64_t) p[4] << 32
+	  | (bfd_uint64_t) p[5] << 40
+	  | (bfd_uint64_t) p[6] << 48
+	  | (bfd_uint64_t) p[7] << 56);
+}
+
+static bfd_uint64_t
+xxh64_round (bfd_uint64_t acc, bfd_uint64_t input)
+{
+  acc += input * XXH_PRIME64_2;
+  acc = XXH_ROTL64 (acc, 31);
+  return acc * XXH_PRIME64_1;
+}
+
+static bfd_uint64_t
+xxh64_merge_round (bfd_uint64_t acc, bfd_uint64_t val)
+{
+  acc ^= xxh64_round (0, val);
+  return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+static void
+xxh64_init_ctx (struct xxh64_ctx *ctx)
+{
+  ctx->v[0] = XXH_PRIME64_1 + XXH_PRIME64_2;
+  ctx->v[1] = XXH_PRIME64_2;
+  ctx->v[2] = 0;
+  ctx->v[3] = -XXH_PRIME64_1;
+  ctx->total = 0;
+  ctx->buflen = 0;
+}
+
+/* Hash whole 32-byte stripes of P, LEN bytes long, into CTX.  Return
+   the number of bytes consumed.  */
+
+static size_t
+xxh64_stripes (struct xxh64_ctx *ctx, const unsigned char *p, size_t len)
+{
+  bfd_uint64_t v0 = ctx->v[0], v1 = ctx->v[1];
+  bfd_uint64_t v2 = ctx->v[2], v3 = ctx->v[3];
+  size_t done;
+
+  for (done = 0; len - done >= 32; done += 32)
+    {
+      v0 = xxh64_round (v0, xxh64_read64 (p + done));
+      v1 = xxh64_round (v1, xxh64_read64 (p + done + 8));
+      v2 = xxh64_round (v2, xxh64_read64 (p + done + 16));
+      v3 = xxh64_round (v3, xxh64_read64 (p + done + 24));
+    }
+  ctx->v[0] = v0;
+  ctx->v[1] = v1;
+  ctx->v[2] = v2;
+  ctx->v[3] = v3;
+  return done;
+}
+
+static void
+xxh64_process_bytes (const void *buffer, size_t len, void *arg)
+{
+  struct xxh64_ctx *ctx = (struct xxh64_ctx *) arg;
+  const unsigned char *p = (const unsigned char *) buffer;
+  size_t done;
+
+  ctx->total += len;
+  if (ctx->buflen != 0)
+    {
+      size_t n = sizeof ctx->buf - ctx->buflen;
+
+      if (n > len)
+	n = len;
+      memcpy (ctx->buf + ctx->buflen, p, n);
+      ctx->buflen += n;
+      p += n;
+      len -= n;
+      if (ctx->buflen < sizeof ctx->buf)
+	return;
+      xxh64_stripes (ctx, ctx->buf, sizeof ctx->buf);
+      ctx->buflen = 0;
+    }
+
+  done = xxh64_stripes (ctx, p, len);
+  memcpy (ctx->buf, p + done, len - done);
+  ctx->buflen = len - done;
+}
+
+static void
+xxh64_finish_ctx (struct xxh64_ctx *ctx, unsigned char *resbuf)
+{
+  const unsigned char *p = ctx->buf;
+  size_t len = ctx->buflen;
+  bfd_uint64_t h;
+  int i;
+
+  if (ctx->total >= 32)
+    {
+      h = (XXH_ROTL64 (ctx->v[0], 1) + XXH_ROTL64 (ctx->v[1], 7)
+	   + XXH_ROTL64 (ctx->v[2], 12) + XXH_ROTL64 (ctx->v[3], 18));
+      for (i = 0; i < 4; i++)
+	h = xxh64_merge_round (h, ctx->v[i]);
+    }
+  else
+    h = XXH_PRIME64_5;
+  h += ctx->total;
+
+  for (; len >= 8; p += 8, len -= 8)
+    {
+      h ^= xxh64_round (0, xxh64_read64 (p));
+      h = XXH_ROTL64 (h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+    }
+  if (len >= 4)
+    {
+      bfd_uint64_t k = ((bfd_uint64_t) p[0] | (bfd_uint64_t) p[1] << 8
+			| (bfd_uint64_t) p[2] << 16
+			| (bfd_uint64_t) p[3] << 24);
+
+      h ^= k * XXH_PRIME64_1;
+      h = XXH_ROTL64 (h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+      p += 4;
+      len -= 4;
+    }
+  for (; len > 0; p++, len--)
+    {
+      h ^= *p * XXH_PRIME64_5;
+      h = XXH_ROTL64 (h, 11) * XXH_PRIME64_1;
+    }
+
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+
+  /* Store the hash big-endian, as xxHash's canonical form does.  */
+  for (i = 7; i >= 0; i--)
+    {
+      resbuf[i] = h & 0xff;
+      h >>= 8;
+    }
+}
+#endif /* BFD_HOST_64_BIT */
+
 bfd_boolean
 validate_build_id_style (const char *style)
 {
  if ((streq (style, "md5")) || (streq (style, "sha1"))
 #ifndef __MINGW32__
      || (streq (style, "uuid"))
+#endif
+#ifdef BFD_HOST_64_BIT
+     || (streq (style, "fast"))
 #endif
      || (strneq (style, "0x", 2)))
    return TRUE;
@@ -50,6 +222,11 @@ compute_build_id_size (const char *style)
   if (streq (style, "sha1"))
     return  160 / 8;
 
+#ifdef BFD_HOST_64_BIT
+  if (streq (style, "fast"))
+    return  64 / 8;
+#endif
+
   if (strneq (style, "0x", 2))
     {
       bfd_size_type size = 0;
@@ -118,6 +295,17 @@ generate_build_id (bfd *abfd,
 	return FALSE;
       sha1_finish_ctx (&ctx, id_bits);
     }
+#ifdef BFD_HOST_64_BIT
+  else if (streq (style, "fast"))
+    {
+      struct xxh64_ctx ctx;
+
+      xxh64_init_ctx (&ctx);
+      if (!(*checksum_contents) (abfd, &xxh64_process_bytes, &ctx))
+	return FALSE;
+      xxh64_finish_ctx (&ctx, id_bits);
+    }
+#endif
 #ifndef __MINGW32__
   else if (streq (style, "uuid"))
     {
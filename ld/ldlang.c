@@ -70,6 +70,24 @@ static lang_statement_list_type **stat_save_ptr = &stat_save[0];
 static struct unique_sections *unique_section_list;
 static struct asneeded_minfo *asneeded_list_head;
 
+/* Relaxation statistics, reported by --stats.  */
+static struct
+{
+  int passes;
+  int trips;
+  unsigned long calls;
+  unsigned long resized;
+  long time;
+} relax_stats;
+
+/* Garbage collection statistics, reported by --stats.  */
+static struct
+{
+  unsigned long kept;
+  unsigned long discarded;
+  long time;
+} gc_stats;
+
 /* Forward declarations.  */
 static void exp_init_os (etree_type *);
 static lang_input_statement_type *lookup_name (const char *);
@@ -300,6 +318,197 @@ walk_wild_section_general (lang_wild_statement_type *ptr,
     }
 }
 
+/* Files with fewer sections than this are not worth indexing.  */
+#define WILD_SECTION_INDEX_MIN 16
+
+/* The sections of an input bfd sorted by name.  POS is a section's
+   position in the bfd's section list.  */
+
+struct wild_section_index_entry
+{
+  const char *name;
+  asection *section;
+  unsigned int pos;
+};
+
+struct wild_section_index
+{
+  /* The bfd and its section count when the index was built.  */
+  bfd *abfd;
+  unsigned int section_count;
+  unsigned int count;
+  struct wild_section_index_entry entries[1];
+};
+
+/* A section matched by a spec, in walk_wild_section_indexed.  */
+
+struct wild_section_match
+{
+  unsigned int pos;
+  unsigned int spec;
+  asection *section;
+  struct wildcard_list *sec;
+};
+
+static int
+wild_section_index_cmp (const void *a, const void *b)
+{
+  const struct wild_section_index_entry *ea = a;
+  const struct wild_section_index_entry *eb = b;
+  int ret = strcmp (ea->name, eb->name);
+
+  if (ret == 0)
+    ret = ea->pos < eb->pos ? -1 : ea->pos > eb->pos;
+  return ret;
+}
+
+static int
+wild_section_match_cmp (const void *a, const void *b)
+{
+  const struct wild_section_match *ma = a;
+  const struct wild_section_match *mb = b;
+
+  if (ma->pos != mb->pos)
+    return ma->pos < mb->pos ? -1 : 1;
+  return ma->spec < mb->spec ? -1 : ma->spec > mb->spec;
+}
+
+/* Return the section name index for FILE, building it if FILE has
+   none yet or if sections have been added since it was built.  */
+
+static struct wild_section_index *
+get_wild_section_index (lang_input_statement_type *file)
+{
+  struct wild_section_index *sindex = file->section_index;
+  bfd *abfd = file->the_bfd;
+  asection *s;
+  unsigned int count;
+
+  if (sindex != NULL
+      && sindex->abfd == abfd
+      && sindex->section_count == abfd->section_count)
+    return sindex;
+
+  free (sindex);
+  sindex = xmalloc (sizeof (*sindex)
+		   + abfd->section_count * sizeof (sindex->entries[0]));
+  sindex->abfd = abfd;
+  sindex->section_count = abfd->section_count;
+  count = 0;
+  for (s = abfd->sections; s != NULL; s = s->next)
+    {
+      /* Cope with a section list longer than section_count.  */
+      if (count == abfd->section_count)
+	{
+	  free (sindex);
+	  file->section_index = NULL;
+	  return NULL;
+	}
+      sindex->entries[count].name = bfd_get_section_name (abfd, s);
+      sindex->entries[count].section = s;
+      sindex->entries[count].pos = count;
+      count++;
+    }
+  sindex->count = count;
+  qsort (sindex->entries, count, sizeof (sindex->entries[0]),
+	 wild_section_index_cmp);
+  file->section_index = sindex;
+  return sindex;
+}
+
+/* Return the length of the literal prefix of section spec PATTERN.
+   Like name_match, treat PATTERN as a plain name if it has no
+   wildcards; otherwise stop at the first character that fnmatch
+   treats specially.  */
+
+static size_t
+wild_spec_prefix_len (const char *pattern)
+{
+  if (!wildcardp (pattern))
+    return strlen (pattern);
+  return strcspn (pattern, "?*[\\");
+}
+
+/* Handle section specs which all start with a literal prefix, by
+   looking up each prefix in a sorted sindex of FILE's sections rather
+   than matching every section against every spec.  The matching
+   sections are then passed to the callback in the same order as
+   walk_wild_section_general would.  */
+
+static void
+walk_wild_section_indexed (lang_wild_statement_type *ptr,
+			   lang_input_statement_type *file,
+			   callback_t callback,
+			   void *data)
+{
+  struct wild_section_index *sindex;
+  struct wild_section_match *matches;
+  unsigned int nmatches, nalloc, spec, i;
+  struct wildcard_list *sec;
+
+  if (file->the_bfd->section_count < WILD_SECTION_INDEX_MIN
+      || (sindex = get_wild_section_index (file)) == NULL)
+    {
+      walk_wild_section_general (ptr, file, callback, data);
+      return;
+    }
+
+  matches = NULL;
+  nmatches = 0;
+  nalloc = 0;
+  for (sec = ptr->section_list, spec = 0; sec != NULL; sec = sec->next, spec++)
+    {
+      const char *pattern = sec->spec.name;
+      size_t len = wild_spec_prefix_len (pattern);
+      bfd_boolean literal = !wildcardp (pattern);
+      unsigned int lo, hi;
+
+      /* Find the first section whose name is not less than the
+	 prefix, then walk the sections that start with the prefix.  */
+      lo = 0;
+      hi = sindex->count;
+      while (lo < hi)
+	{
+	  unsigned int mid = lo + (hi - lo) / 2;
+
+	  if (strncmp (sindex->entries[mid].name, pattern, len) < 0)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+
+      for (i = lo; i < sindex->count; i++)
+	{
+	  const char *sname = sindex->entries[i].name;
+
+	  if (strncmp (sname, pattern, len) != 0)
+	    break;
+	  if (literal
+	      ? sname[len] != '\0'
+	      : fnmatch (pattern, sname, 0) != 0)
+	    continue;
+
+	  if (nmatches == nalloc)
+	    {
+	      nalloc = nalloc ? nalloc * 2 : 16;
+	      matches = xrealloc (matches, nalloc * sizeof (*matches));
+	    }
+	  matches[nmatches].pos = sindex->entries[i].pos;
+	  matches[nmatches].spec = spec;
+	  matches[nmatches].section = sindex->entries[i].section;
+	  matches[nmatches].sec = sec;
+	  nmatches++;
+	}
+    }
+
+  if (nmatches > 1)
+    qsort (matches, nmatches, sizeof (*matches), wild_section_match_cmp);
+  for (i = 0; i < nmatches; i++)
+    walk_wild_consider_section (ptr, file, matches[i].section,
+				matches[i].sec, callback, data);
+  free (matches);
+}
+
 /* Routines to find a single section given its name.  If there's more
    than one section with that name, we report that.  */
 
@@ -768,6 +977,8 @@ analyze_walk_wild_section_handler (lang_wild_statement_type *ptr)
   struct wildcard_list *sec;
   int signature;
   int data_counter;
+  bfd_boolean complex_wild = FALSE;
+  bfd_boolean unprefixed = FALSE;
 
   ptr->walk_wild_section_handler = walk_wild_section_general;
   ptr->handler_data[0] = NULL;
@@ -779,9 +990,11 @@ analyze_walk_wild_section_handler (lang_wild_statement_type *ptr)
   /* Count how many wildcard_specs there are, and how many of those
      actually use wildcards in the name.  Also, bail out if any of the
      wildcard names are NULL. (Can this actually happen?
-     walk_wild_section used to test for it.)  And bail out if any
-     of the wildcards are more complex than a simple string
-     ending in a single '*'.  */
+     walk_wild_section used to test for it.)  Note whether any spec
+     has no literal prefix, which rules out the section index, and
+     whether any wildcard is more complex than a simple string ending
+     in a single '*', which rules out the specialized handlers
+     below but not the section index.  */
   for (sec = ptr->section_list; sec != NULL; sec = sec->next)
     {
       ++sec_count;
@@ -791,14 +1004,22 @@ analyze_walk_wild_section_handler (lang_wild_statement_type *ptr)
 	{
 	  ++wild_name_count;
 	  if (!is_simple_wild (sec->spec.name))
-	    return;
+	    complex_wild = TRUE;
 	}
+      if (wild_spec_prefix_len (sec->spec.name) == 0)
+	unprefixed = TRUE;
     }
 
+  /* Specs that each start with a literal prefix can be looked up in
+     a sorted index of the file's sections.  That does not help if
+     any spec might match any section.  */
+  if (sec_count != 0 && !unprefixed)
+    ptr->walk_wild_section_handler = walk_wild_section_indexed;
+
   /* The zero-spec case would be easy to optimize but it doesn't
      happen in practice.  Likewise, more than 4 specs doesn't
      happen in practice.  */
-  if (sec_count == 0 || sec_count > 4)
+  if (complex_wild || sec_count == 0 || sec_count > 4)
     return;
 
   /* Check that no two specs can match the same section.  */
@@ -1256,6 +1477,12 @@ lang_init (void)
 void
 lang_finish (void)
 {
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      free (f->section_index);
+      f->section_index = NULL;
+    }
+
   bfd_hash_table_free (&lang_definedness_table);
   output_section_statement_table_free ();
 }
@@ -5240,14 +5467,20 @@ lang_size_sections_1
 	    asection *i;
 
 	    i = s->input_section.section;
-	    if (relax)
+	    /* There is no point relaxing a section that will not be
+	       output.  */
+	    if (relax && (i->flags & SEC_EXCLUDE) == 0)
 	      {
 		bfd_boolean again;
+		bfd_size_type old_size = i->size;
 
 		if (! bfd_relax_section (i->owner, i, &link_info, &again))
 		  einfo (_("%P%F: can't relax section: %E\n"));
 		if (again)
 		  *relax = TRUE;
+		relax_stats.calls++;
+		if (i->size != old_size)
+		  relax_stats.resized++;
 	      }
 	    dot = size_input_section (prev, output_section_statement,
 				      fill, dot);
@@ -6432,6 +6665,31 @@ lang_gc_sections_1 (lang_statement_union_type *s)
     }
 }
 
+/* Return the number of input sections with SEC_EXCLUDE set, and
+   store the number of input sections in *TOTAL if TOTAL is not NULL.  */
+
+static unsigned long
+count_excluded_input_sections (unsigned long *total)
+{
+  unsigned long excluded = 0;
+  unsigned long count = 0;
+
+  LANG_FOR_EACH_INPUT_STATEMENT (f)
+    {
+      asection *sec;
+
+      for (sec = f->the_bfd->sections; sec != NULL; sec = sec->next)
+	{
+	  count++;
+	  if ((sec->flags & SEC_EXCLUDE) != 0)
+	    excluded++;
+	}
+    }
+  if (total != NULL)
+    *total = count;
+  return excluded;
+}
+
 static void
 lang_gc_sections (void)
 {
@@ -6458,7 +6716,34 @@ lang_gc_sections (void)
     }
 
   if (link_info.gc_sections)
-    bfd_gc_sections (link_info.output_bfd, &link_info);
+    {
+      unsigned long excluded = count_excluded_input_sections (NULL);
+      unsigned long total;
+      long start_time = get_run_time ();
+
+      bfd_gc_sections (link_info.output_bfd, &link_info);
+      gc_stats.time = get_run_time () - start_time;
+
+      /* The sweep sets SEC_EXCLUDE on the sections it discards, and
+	 never clears it.  */
+      gc_stats.discarded = count_excluded_input_sections (&total) - excluded;
+      gc_stats.kept = total - excluded - gc_stats.discarded;
+    }
+}
+
+/* Print the garbage collection statistics for --stats.  */
+
+void
+lang_print_gc_stats (void)
+{
+  if (!link_info.gc_sections)
+    return;
+
+  fprintf (stderr, _("%s: garbage collection: %lu sections kept, "
+		     "%lu discarded\n"),
+	   program_name, gc_stats.kept, gc_stats.discarded);
+  fprintf (stderr, _("%s: time in garbage collection: %ld.%06ld\n"),
+	   program_name, gc_stats.time / 1000000, gc_stats.time % 1000000);
 }
 
 /* Worker for lang_find_relro_sections_1.  */
@@ -6546,6 +6831,7 @@ lang_relax_sections (bfd_boolean need_layout)
     {
       /* We may need more than one relaxation pass.  */
       int i = link_info.relax_pass;
+      long start_time = get_run_time ();
 
       /* The backend can use it to determine the current pass.  */
       link_info.relax_pass = 0;
@@ -6579,8 +6865,11 @@ lang_relax_sections (bfd_boolean need_layout)
 	    }
 	  while (relax_again);
 
+	  relax_stats.trips += link_info.relax_trip + 1;
 	  link_info.relax_pass++;
 	}
+      relax_stats.passes += link_info.relax_pass;
+      relax_stats.time += get_run_time () - start_time;
       need_layout = TRUE;
     }
 
@@ -6593,6 +6882,23 @@ lang_relax_sections (bfd_boolean need_layout)
     }
 }
 
+/* Print statistics gathered by lang_relax_sections, for --stats.  */
+
+void
+lang_print_relax_stats (void)
+{
+  if (relax_stats.passes == 0)
+    return;
+
+  fprintf (stderr, _("%s: relaxation: %d passes, %d trips\n"),
+	   program_name, relax_stats.passes, relax_stats.trips);
+  fprintf (stderr, _("%s: relaxation: %lu sections relaxed, %lu resized\n"),
+	   program_name, relax_stats.calls, relax_stats.resized);
+  fprintf (stderr, _("%s: time in relaxation: %ld.%06ld\n"),
+	   program_name, relax_stats.time / 1000000,
+	   relax_stats.time % 1000000);
+}
+
 #ifdef ENABLE_PLUGINS
 /* Find the insert point for the plugin's replacement files.  We
    place them after the first claimed real object file, or if the
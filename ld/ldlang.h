@@ -301,6 +301,10 @@ typedef struct lang_input_statement_struct
 
   struct flag_info *section_flag_list;
 
+  /* The sections of THE_BFD sorted by name, built when first needed
+     to match wildcard section specs against this file.  */
+  struct wild_section_index *section_index;
+
   /* Point to the next file - whatever it is, wanders up and down
      archives */
   union lang_statement_union *next;
@@ -543,6 +547,10 @@ extern void lang_final
   (void);
 extern void lang_relax_sections
   (bfd_boolean);
+extern void lang_print_relax_stats
+  (void);
+extern void lang_print_gc_stats
+  (void);
 extern void lang_process
   (void);
 extern void lang_section_start
@@ -213,6 +213,12 @@ main (int argc, char **argv)
 
   bfd_set_error_program_name (program_name);
 
+  /* Links can have many thousands of input files.  Let BFD keep as
+     many of them open as the system allows.  This is always done;
+     it raises the soft limit on open files for the linker and for
+     any program it runs.  */
+  bfd_cache_raise_limit ();
+
   /* We want to notice and fail on those nasty BFD assertions which are
      likely to signal incorrect output being generated but otherwise may
      leave no trace.  */
@@ -517,6 +523,22 @@ main (int argc, char **argv)
       fflush (stdout);
       fprintf (stderr, _("%s: total time in link: %ld.%06ld\n"),
 	       program_name, run_time / 1000000, run_time % 1000000);
+      lang_print_relax_stats ();
+      lang_print_gc_stats ();
+      if (link_info.archive_passes != 0)
+	fprintf (stderr, _("%s: archive symbol passes: %lu, "
+			   "symbols looked up: %lu\n"),
+		 program_name, link_info.archive_passes,
+		 link_info.archive_lookups);
+      {
+	struct bfd_cache_stats cache_stats;
+
+	bfd_cache_get_stats (&cache_stats);
+	fprintf (stderr, _("%s: file cache: %d files max, %lu hits, "
+			   "%lu reopens, %lu closes\n"),
+		 program_name, cache_stats.max_open, cache_stats.hits,
+		 cache_stats.reopens, cache_stats.closes);
+      }
 #ifdef HAVE_SBRK
       fprintf (stderr, _("%s: data size %ld\n"), program_name,
 	       (long) (lim - start_sbrk));
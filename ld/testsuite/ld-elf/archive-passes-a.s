@@ -0,0 +1,4 @@
+ .data
+ .globl archive_pass_a
+archive_pass_a:
+ .dc.a archive_pass_b
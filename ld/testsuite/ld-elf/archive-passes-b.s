@@ -0,0 +1,4 @@
+ .data
+ .globl archive_pass_b
+archive_pass_b:
+ .dc.a archive_pass_c
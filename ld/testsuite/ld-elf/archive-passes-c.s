@@ -0,0 +1,4 @@
+ .data
+ .globl archive_pass_c
+archive_pass_c:
+ .dc.a 0
@@ -0,0 +1,2 @@
+ .data
+ .dc.a archive_pass_a
@@ -0,0 +1,12 @@
+	.section .text._start,"ax",@progbits
+	.global _start
+_start:
+	jmp	used
+
+	.section .text.unused,"ax",@progbits
+unused:
+	jmp	_start
+
+	.section .text.used,"ax",@progbits
+used:
+	nop
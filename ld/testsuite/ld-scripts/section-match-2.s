@@ -0,0 +1,56 @@
+        .section .text.c2
+        .ascii "c2"
+
+        .section .text.b
+        .ascii "b"
+
+        .section .text.a2
+        .ascii "a2"
+
+        .section .text.d2
+        .ascii "d2"
+
+        .section .text.c
+        .ascii "c"
+
+        .section .text.a
+        .ascii "a"
+
+        .section .text.e
+        .ascii "e"
+
+        .section .text.d1
+        .ascii "d1"
+
+        .section .text.b2
+        .ascii "b2"
+
+        .section .text.c1
+        .ascii "c1"
+
+        .section .text.a1
+        .ascii "a1"
+
+        .section .text.f
+        .ascii "f"
+
+        .section .text.d
+        .ascii "d"
+
+        .section .text.b1
+        .ascii "b1"
+
+        .section .t_other
+        .ascii "t_"
+
+        .section .text.g
+        .ascii "g"
+
+        .section .text.h
+        .ascii "h"
+
+        .section .text.e1
+        .ascii "e1"
+
+        .section .text.f1
+        .ascii "f1"
@@ -0,0 +1,15 @@
+SECTIONS
+{
+	/* Each of these statements has specs that can match the same
+	   section, and the object has enough sections for ld to look
+	   the specs up in a sorted index of them.  A section goes to
+	   the first statement that matches it, and within a statement
+	   sections are placed in input order, not spec order.  */
+	.one : { *(.text.c .text.a* .text.c*) }
+	.two : { *(.text.[ab]* .text.b) }
+	.three : { *(SORT_BY_NAME(.text.d*) .text.e*) }
+	.four : { *(.text.? .t*) }
+
+	/* Ignore anything else.  */
+	/DISCARD/ : { *(*) }
+}